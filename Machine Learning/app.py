@@ -5,6 +5,8 @@ import matplotlib.pyplot as plt
 import joblib
 import subprocess
 import threading
+import urllib.parse
+import urllib.request
 
 import csv
 from sklearn.ensemble import RandomForestClassifier
@@ -13,12 +15,15 @@ from sklearn.model_selection import train_test_split
 from sklearn.metrics import classification_report
 from flask import Flask, request, jsonify
 from datetime import datetime
+from exportar_modelo import calcular_novedad, es_novedad, exportar_cabecera
+from caracteristicas import calcular_caracteristicas, entradas_modelo, es_caracteristica, leer_cocientes
 
 st.set_page_config(page_title="Detector de Materiales", layout="centered")
 st.title("🔬 Identificador de Materiales con Sensor AS7265x")
 
 # Constantes
 CANALES = ['A','B','C','D','E','F','G','H','R','I','S','J','T','U','V','W','K','L']
+
 MODELOS_DIR = "modelos_guardados"
 os.makedirs(MODELOS_DIR, exist_ok=True)
 
@@ -29,6 +34,8 @@ if "escalador" not in st.session_state:
     st.session_state.escalador = None
 if "modelo_entrenado" not in st.session_state:
     st.session_state.modelo_entrenado = False
+if "novedad" not in st.session_state:
+    st.session_state.novedad = None
 
 # ------------------ Sección 1: Servidor Flask ------------------
 
@@ -90,6 +97,22 @@ if iniciar_servidor:
     except Exception as e:
         st.error(f"❌ Error iniciando ngrok: {e}")
 
+# Descarga directa por la red local: el ESP32 genera el CSV completo en /export.csv
+st.subheader("📥 Descargar dataset directamente del ESP32")
+ip_esp32 = st.text_input("Dirección IP del ESP32 en la red local", "192.168.4.1")
+
+if st.button("Descargar tramas del sensor"):
+    url = f"http://{ip_esp32}/export.csv?label={urllib.parse.quote(nombre_medicion.lower().strip())}"
+    try:
+        with urllib.request.urlopen(url, timeout=30) as respuesta:
+            contenido = respuesta.read()
+        with open(CSV_FILE, 'wb') as f:
+            f.write(contenido)
+        filas = max(contenido.count(b'\n') - 1, 0)
+        st.success(f"✅ {filas} tramas guardadas en {CSV_FILE}")
+    except Exception as e:
+        st.error(f"❌ No se pudo descargar desde {url}: {e}")
+
 
 # ------------------ Sección 2: Entrenamiento ------------------
 
@@ -116,9 +139,20 @@ if archivos_entrenamiento:
         df_total = pd.concat(dataframes, ignore_index=True)
         st.success(f"✅ Se cargaron {len(df_total)} muestras.")
 
+        # Las mismas que calcula la placa (TFG/main/spectral.c), que las evalúa al clasificar
+        usar_caracteristicas = st.checkbox("Añadir características espectrales (normalizados, derivada y cocientes)")
+        texto_cocientes = st.text_input("Cocientes de bandas", "R/G,C/R,W/S", disabled=not usar_caracteristicas)
+
         if st.button("🧠 Entrenar modelo"):
             X = df_total[CANALES]
             y = df_total['material']
+            if usar_caracteristicas:
+                try:
+                    cocientes = leer_cocientes(texto_cocientes)
+                except ValueError as e:
+                    st.error(f"❌ {e}")
+                    st.stop()
+                X = pd.concat([X, calcular_caracteristicas(df_total, cocientes)], axis=1)
 
             scaler = StandardScaler()
             X_scaled = scaler.fit_transform(X)
@@ -132,6 +166,8 @@ if archivos_entrenamiento:
             st.session_state.modelo = clf
             st.session_state.escalador = scaler
             st.session_state.modelo_entrenado = True
+            # Distribución de cada material (con todas sus muestras) para detectar novedades
+            st.session_state.novedad = calcular_novedad(X_scaled, y, scaler)
 
             y_pred = clf.predict(X_test)
             reporte = classification_report(y_test, y_pred, output_dict=False)
@@ -151,7 +187,8 @@ if st.session_state.modelo_entrenado:
         with open(ruta, "wb") as f:
             joblib.dump({
                 "modelo": st.session_state.modelo,
-                "escalador": st.session_state.escalador
+                "escalador": st.session_state.escalador,
+                "novedad": st.session_state.novedad
             }, f)
         st.success(f"✅ Modelo guardado como '{nombre_guardado}.pkl'")
 else:
@@ -169,11 +206,71 @@ if modelos_disponibles:
             datos = joblib.load(f)
             st.session_state.modelo = datos["modelo"]
             st.session_state.escalador = datos["escalador"]
+            # Los modelos guardados antes del detector de novedad no la traen
+            st.session_state.novedad = datos.get("novedad")
             st.session_state.modelo_entrenado = True
         st.success(f"📦 Modelo '{modelo_seleccionado}' cargado correctamente.")
 else:
     st.info("No hay modelos guardados todavía.")
 
+# Máscara de canales para el firmware (CONFIG_AS7265X_CHANNEL_MASK o RPC setChannelMask)
+st.subheader("🎯 Exportar máscara de canales al firmware")
+
+if st.session_state.modelo_entrenado and hasattr(st.session_state.modelo, "feature_importances_"):
+    umbral = st.slider("Importancia acumulada a conservar", 0.5, 1.0, 0.9, 0.05)
+
+    columnas = list(getattr(st.session_state.escalador, "feature_names_in_", CANALES))
+    importancias = pd.Series(st.session_state.modelo.feature_importances_, index=columnas).sort_values(ascending=False)
+    acumulada = importancias.cumsum()
+    # Canales más importantes hasta alcanzar el umbral (al menos uno)
+    seleccion = list(importancias.index[:int((acumulada < umbral).sum()) + 1])
+    # Los normalizados y la derivada dependen de todos los canales
+    if any(es_caracteristica(c) for c in seleccion):
+        st.info("Hay características espectrales entre las importantes: se necesitan los 18 canales.")
+        seleccion = CANALES
+
+    # Bit i = canal i en el orden del firmware (RSTUVW GHIJKL ABCDEF)
+    mascara = sum(1 << expected_channels.index(c) for c in seleccion)
+    dispositivos = [d for d in range(3) if mascara & (0x3F << (d * 6))]
+    canales_ordenados = [c for c in expected_channels if c in seleccion]
+    # Accesos a registro virtual como en read_sensor_values (as7265x.c): por cada
+    # dispositivo leído, DEV_SEL, 2 por canal y la temperatura
+    accesos = sum(2 + 2 * sum(c in seleccion for c in expected_channels[d * 6:d * 6 + 6]) for d in dispositivos)
+
+    st.dataframe(pd.DataFrame({"Importancia": importancias, "Acumulada": acumulada}).style.format("{:.1%}"))
+    st.write(f"Canales: **{' '.join(canales_ordenados)}** ({len(seleccion)} de 18), "
+             f"dispositivos leídos: {', '.join(expected_channels[d * 6] + '–' + expected_channels[d * 6 + 5] for d in dispositivos)}")
+    st.write(f"Accesos a registro virtual por trama: {accesos} de 42")
+    st.code(f"CONFIG_AS7265X_CHANNEL_MASK=0x{mascara:05X}", language="text")
+    st.code(f'{{"method": "setChannelMask", "params": {{"mask": {mascara}}}}}', language="json")
+    st.caption("Los canales fuera de la máscara llegan a 0: entrena el modelo que vaya a usarse con ella "
+               "solo con esos canales. El banco de pruebas del target linux mide las tramas/s con "
+               f"BENCH_MASK={mascara:X}.")
+else:
+    st.info("Entrena o carga un modelo de bosque aleatorio para calcular la máscara.")
+
+# Bosque para clasificar en la placa (TFG/main/classifier_model.h, CONFIG_CLASSIFIER_ENABLED)
+st.subheader("🌲 Exportar modelo al firmware")
+
+if st.session_state.modelo_entrenado and hasattr(st.session_state.modelo, "estimators_"):
+    try:
+        cabecera = exportar_cabecera(st.session_state.modelo, st.session_state.escalador,
+                                     novedad=st.session_state.novedad)
+        nodos = sum(arbol.tree_.node_count for arbol in st.session_state.modelo.estimators_)
+        st.write(f"{len(st.session_state.modelo.estimators_)} árboles, {nodos} nodos "
+                 f"(unos {nodos * 12 // 1024} KB de flash)")
+        st.download_button("Descargar classifier_model.h", cabecera, file_name="classifier_model.h", mime="text/x-c")
+        st.caption("Sustituye TFG/main/classifier_model.h y recompila con CONFIG_CLASSIFIER_ENABLED. "
+                   "Los umbrales van en cuentas crudas: la placa no necesita el escalador. Las características "
+                   "espectrales las calcula la placa con los cocientes que lleva el modelo.")
+        if st.session_state.novedad is None:
+            st.caption("Este modelo no trae el detector de novedad: vuelve a entrenarlo para que la placa "
+                       "marque las tramas de materiales desconocidos (\"novel\").")
+    except ValueError as e:
+        st.error(f"❌ {e}")
+else:
+    st.info("Entrena o carga un modelo de bosque aleatorio para exportarlo.")
+
 # ------------------ Sección 4: Predicción ------------------
 
 st.header("🔎 Analizar nueva medición")
@@ -196,7 +293,7 @@ if archivo_medicion:
         escalador = st.session_state.escalador
 
         if modelo and escalador:
-            X = df[CANALES]
+            X = entradas_modelo(df, list(getattr(escalador, "feature_names_in_", CANALES)))
             X_scaled = escalador.transform(X)
             pred = modelo.predict(X_scaled)
             probas = modelo.predict_proba(X_scaled)
@@ -210,6 +307,12 @@ if archivo_medicion:
 
             if max_proba < 0.6:
                 st.warning("⚠️ El modelo no está seguro de esta predicción. Podría tratarse de un material no conocido.")
+            # El mismo criterio que la placa: lejos de la distribución del material predicho
+            if st.session_state.novedad is not None:
+                nuevas = sum(es_novedad(st.session_state.novedad, clase, X.iloc[[i]])[0] for i, clase in enumerate(pred))
+                if nuevas:
+                    st.warning(f"⚠️ {nuevas} de {len(pred)} mediciones quedan fuera de la distribución del material "
+                               "predicho: probablemente es un material no conocido.")
 
             st.subheader("🔍 Probabilidades por clase:")
             df_probas = pd.DataFrame({
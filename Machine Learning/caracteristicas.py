@@ -0,0 +1,78 @@
+# caracteristicas.py
+# Las mismas características espectrales que calcula el firmware
+# (TFG/main/spectral.c), entero a entero, para entrenar con ellas y que los
+# umbrales exportados valgan en la placa:
+# - "A_a": espectro normalizado por área, Q14 (16384 = 1,0)
+# - "A_v": espectro normalizado por norma euclídea, Q14
+# - "A_d": primera derivada (de A a B) del normalizado por área, Q14
+# - "W/R": cociente de canales, Q8 (256 = 1,0) saturado a 65535
+# La telemetría los publica con esos nombres ya divididos entre 16384 o 256.
+
+import math
+
+import numpy as np
+import pandas as pd
+
+# Canales por longitud de onda (410-940 nm), el orden de spectral.c
+BANDAS = ['A','B','C','D','E','F','G','H','R','I','S','J','T','U','V','W','K','L']
+MAX_COCIENTES = 8
+SUFIJOS = ("_d", "_a", "_v")
+
+
+def leer_cocientes(texto):
+    """Convierte "R/G,C/R" en [("R", "G"), ("C", "R")], como CONFIG_SPECTRAL_RATIOS."""
+    pares = []
+    for par in filter(None, (p.strip().upper() for p in texto.split(","))):
+        num, _, den = par.partition("/")
+        if num not in BANDAS or den not in BANDAS:
+            raise ValueError(f"Cociente no válido: {par}")
+        pares.append((num, den))
+    if len(pares) > MAX_COCIENTES:
+        raise ValueError(f"Como mucho {MAX_COCIENTES} cocientes")
+    return pares
+
+
+def nombres(cocientes):
+    """Columnas que añade calcular_caracteristicas, en el orden de spectral_features_t (spectral_compute)."""
+    return ([f"{b}_d" for b in BANDAS[:-1]] + [f"{b}_a" for b in BANDAS] + [f"{b}_v" for b in BANDAS] +
+            [f"{n}/{d}" for n, d in cocientes])
+
+
+def es_caracteristica(columna):
+    return columna.endswith(SUFIJOS) or "/" in columna
+
+
+def calcular_caracteristicas(df, cocientes=()):
+    """DataFrame con las columnas de nombres(cocientes) para las filas de df (con los canales)."""
+    x = df[BANDAS].values.astype(np.int64)
+    filas = []
+
+    for v in x:
+        fila = []
+        maximo = int(v.max())
+        if maximo == 0:
+            derivada, area, vector = [0] * 17, [0] * 18, [0] * 18
+        else:
+            # Coma flotante por bloque: el máximo en [16384, 32767]
+            b = v >> 1 if maximo > 32767 else v << (15 - maximo.bit_length())
+            c_area = min((1 << 29) // int(b.sum()), 32767)
+            c_vector = min((1 << 29) // math.isqrt(int((b * b).sum())), 32767)
+            area = list((b * c_area) >> 15)
+            vector = list((b * c_vector) >> 15)
+            derivada = [area[i + 1] - area[i] for i in range(17)]
+        fila += derivada + area + vector
+
+        for n, d in cocientes:
+            num, den = int(v[BANDAS.index(n)]), int(v[BANDAS.index(d)])
+            fila.append(min((num << 8) // den, 65535) if den else (65535 if num else 0))
+        filas.append(fila)
+
+    return pd.DataFrame(filas, columns=nombres(cocientes), index=df.index)
+
+
+def entradas_modelo(df, columnas):
+    """Las columnas de un modelo (canales y características) para las filas de df."""
+    if any(es_caracteristica(c) for c in columnas):
+        cocientes = [tuple(c.split("/")) for c in columnas if "/" in c]
+        df = pd.concat([df, calcular_caracteristicas(df, cocientes)], axis=1)
+    return df[columnas]
@@ -0,0 +1,205 @@
+# exportar_modelo.py
+# Convierte un bosque aleatorio entrenado en app.py (modelo + escalador) en la
+# cabecera TFG/main/classifier_model.h que evalúa el firmware. Los umbrales se
+# pasan de la escala del StandardScaler a cuentas crudas del sensor, así que la
+# placa compara enteros sin escalar la trama. Las características de
+# caracteristicas.py (p. ej. "A_a" o "W/R") pasan a entradas 18 y siguientes,
+# que la placa calcula con spectral.c.
+#
+# Con los datos de entrenamiento se exporta también el detector de novedad:
+# por clase, la media y la matriz de blanqueo de su covarianza (Ledoit-Wolf),
+# para que la placa calcule la distancia de Mahalanobis en punto fijo.
+#
+#   python exportar_modelo.py "modelos_guardados/Modelo de papeles.pkl" [datos_materiales] > ../TFG/main/classifier_model.h
+
+import glob
+import math
+import os
+import sys
+
+import joblib
+import numpy as np
+from scipy.stats import chi2
+from sklearn.covariance import LedoitWolf
+
+from caracteristicas import BANDAS, MAX_COCIENTES, entradas_modelo, es_caracteristica
+
+CANALES = ['A','B','C','D','E','F','G','H','R','I','S','J','T','U','V','W','K','L']
+# Orden de los canales en el firmware (RSTUVW GHIJKL ABCDEF)
+CANALES_FIRMWARE = ['R','S','T','U','V','W','G','H','I','J','K','L','A','B','C','D','E','F']
+
+
+def _entrada_firmware(columna, cocientes):
+    """Índice de la entrada del clasificador de la placa para una columna."""
+    if columna in CANALES_FIRMWARE:
+        return CANALES_FIRMWARE.index(columna)
+    banda, sufijo = columna[:-2], columna[-2:]
+    # Mismo orden que spectral.h: derivada (17), área (18), norma (18), cocientes
+    if sufijo == "_d":
+        return 18 + BANDAS.index(banda)
+    if sufijo == "_a":
+        return 18 + 17 + BANDAS.index(banda)
+    if sufijo == "_v":
+        return 18 + 35 + BANDAS.index(banda)
+    return 18 + 53 + cocientes.index(columna)
+
+
+def _umbral_crudo(umbral, media, escala):
+    # x_escalado <= umbral  <=>  x <= umbral * escala + media; con x entero basta el suelo
+    return math.floor(umbral * escala + media)
+
+
+def calcular_novedad(X_escalado, y, escalador, confianza=0.999):
+    """Media, matriz de blanqueo W (d² = |W (x - media)|², en cuentas crudas) y
+    umbral de d² de cada clase, en el orden de canales del firmware."""
+    columnas = list(getattr(escalador, "feature_names_in_", CANALES))
+    orden = [columnas.index(c) for c in CANALES_FIRMWARE]
+    X_escalado, y = np.asarray(X_escalado), np.asarray(y)
+    novedad = {}
+
+    for clase in np.unique(y):
+        # Solo los 18 canales (sin características) y en el orden del firmware,
+        # para que W sea triangular superior allí
+        Xc = X_escalado[y == clase][:, orden]
+        lw = LedoitWolf().fit(Xc)
+        # precisión = L Lᵀ  =>  d² = |Lᵀ (z - media)|²
+        W = np.linalg.cholesky(lw.precision_).T
+        escala, centro = escalador.scale_[orden], escalador.mean_[orden]
+        # De la escala del StandardScaler a cuentas crudas: z = (x - m) / s
+        media = np.round(lw.location_ * escala + centro)
+        W_crudo = W / escala
+        # d² tal como la calcula la placa, con la media redondeada a cuentas
+        d2 = (((Xc * escala + centro - media) @ W_crudo.T) ** 2).sum(axis=1)
+        # Ninguna muestra de entrenamiento de la clase debe salir como novedad
+        # (con un 5 % de margen para el redondeo del punto fijo)
+        umbral = max(chi2.ppf(confianza, Xc.shape[1]), 1.05 * d2.max())
+        novedad[str(clase)] = (media, W_crudo, umbral)
+    return novedad
+
+
+def es_novedad(novedad, clase, muestras):
+    """Como la placa: True en las filas de muestras (DataFrame con los canales)
+    que quedan fuera de la distribución de clase."""
+    media, W, umbral = novedad[str(clase)]
+    d2 = (((muestras[CANALES_FIRMWARE].values - media) @ W.T) ** 2).sum(axis=1)
+    return d2 > umbral
+
+
+def exportar_cabecera(modelo, escalador, nombre="modelo", novedad=None):
+    """Devuelve el texto de classifier_model.h para un RandomForestClassifier.
+    novedad: el resultado de calcular_novedad, o None para exportar solo el bosque."""
+    clases = [str(c) for c in modelo.classes_]
+    # Columnas con las que se entrenó (los modelos antiguos usaban otro orden)
+    columnas = list(getattr(escalador, "feature_names_in_", CANALES))
+    cocientes = [c for c in columnas if "/" in c]
+    if len(cocientes) > MAX_COCIENTES:
+        raise ValueError(f"El firmware admite como mucho {MAX_COCIENTES} cocientes de bandas")
+    nodos, hojas, raices = [], [], []
+
+    for arbol in modelo.estimators_:
+        t = arbol.tree_
+        base = len(nodos)
+        raices.append(base)
+        for n in range(t.node_count):
+            if t.children_left[n] == -1:
+                valores = t.value[n][0]
+                total = valores.sum()
+                hojas.append([round(255 * v / total) for v in valores])
+                nodos.append((-1, 0, len(hojas) - 1, 0))
+            else:
+                f = t.feature[n]
+                canal = _entrada_firmware(columnas[f], cocientes)
+                umbral = _umbral_crudo(t.threshold[n], escalador.mean_[f], escalador.scale_[f])
+                nodos.append((canal, umbral, base + t.children_left[n], base + t.children_right[n]))
+
+    if len(nodos) > 0xFFFF or len(hojas) > 0xFFFF:
+        raise ValueError(f"El bosque es demasiado grande para el firmware ({len(nodos)} nodos)")
+
+    # Las macros de configuración siempre están (0 o 1), así classifier.c no
+    # depende de que una que falte valga 0 en el #if
+    usa_caracteristicas = any(es_caracteristica(c) for c in columnas)
+    lineas = [
+        f"// Generado por Machine Learning/exportar_modelo.py a partir de \"{nombre}\".",
+        "// No editar a mano: volver a exportar desde app.py (Exportar modelo al firmware).",
+        "#ifndef CLASSIFIER_MODEL_H",
+        "#define CLASSIFIER_MODEL_H",
+        "",
+        "#include <stdint.h>",
+    ]
+    if usa_caracteristicas:
+        lineas.append("#include \"spectral.h\"")
+    lineas += [
+        "",
+        f"#define MODEL_NUM_CLASSES {len(clases)}",
+        f"#define MODEL_NUM_TREES {len(raices)}",
+        f"#define MODEL_NUM_NODES {len(nodos)}",
+        f"#define MODEL_USES_FEATURES {int(usa_caracteristicas)}",
+        f"#define MODEL_NUM_RATIOS {len(cocientes)}",
+        f"#define MODEL_HAS_NOVELTY {int(novedad is not None)}",
+        "",
+        "static const char *const model_classes[MODEL_NUM_CLASSES] = {",
+    ]
+    lineas += [f"    \"{c}\"," for c in clases]
+    lineas += ["};", "", "static const uint16_t model_tree_roots[MODEL_NUM_TREES] = {"]
+    lineas += ["    " + ", ".join(str(r) for r in raices[i:i + 16]) + "," for i in range(0, len(raices), 16)]
+    lineas += ["};", "", "// { canal, umbral (cuentas), izquierda (valor <= umbral) o fila de la hoja, derecha }",
+               "static const model_node_t model_nodes[MODEL_NUM_NODES] = {"]
+    lineas += [f"    {{ {c}, {u}, {i}, {d} }}," for c, u, i, d in nodos]
+    lineas += ["};", "", "// Probabilidad de cada clase en cada hoja (x255)",
+               f"static const uint8_t model_leaf_proba[{len(hojas)}][MODEL_NUM_CLASSES] = {{"]
+    lineas += ["    { " + ", ".join(str(p) for p in h) + " }," for h in hojas]
+    lineas += ["};", ""]
+
+    if usa_caracteristicas:
+        lineas += ["// Entradas desde la 18: características de spectral.c, con estos cocientes",
+                   "static const spectral_ratio_t model_feature_ratios[] = {"]
+        lineas += [f"    {{ {CANALES_FIRMWARE.index(n)}, {CANALES_FIRMWARE.index(d)} }},  // {n}/{d}"
+                   for n, d in (c.split("/") for c in cocientes)] or ["    { 0, 0 },  // sin cocientes"]
+        lineas += ["};", ""]
+
+    if novedad is not None:
+        filas_media, filas_w, umbrales = [], [], []
+        for clase in clases:
+            media, W, umbral = novedad[clase]
+            filas_media.append("    { " + ", ".join(str(int(round(m))) for m in media) + " },")
+            filas_w.append("    {")
+            filas_w += ["        { " + ", ".join(str(int(round(w * 65536))) for w in fila) + " }," for fila in W]
+            filas_w.append("    },")
+            umbrales.append(str(min(int(math.ceil(umbral * 65536)), 0xFFFFFFFF)))
+        lineas += ["// Detector de novedad: media de cada clase (cuentas), matriz de blanqueo (Q16)",
+                   "// y umbral de la distancia de Mahalanobis al cuadrado (Q16)",
+                   "static const int32_t model_novelty_mean[MODEL_NUM_CLASSES][18] = {"]
+        lineas += filas_media
+        lineas += ["};", "", "static const int32_t model_novelty_whiten[MODEL_NUM_CLASSES][18][18] = {"]
+        lineas += filas_w
+        lineas += ["};", "", "static const uint32_t model_novelty_threshold[MODEL_NUM_CLASSES] = {",
+                   "    " + ", ".join(umbrales) + ",", "};", ""]
+
+    lineas += ["#endif // CLASSIFIER_MODEL_H", ""]
+    return "\n".join(lineas)
+
+
+def _leer_datos(carpeta, escalador):
+    """Muestras escaladas y etiquetas de los espectroscopia_<material>.csv de una carpeta."""
+    import pandas as pd
+
+    columnas = list(getattr(escalador, "feature_names_in_", CANALES))
+    dfs = []
+    for ruta in sorted(glob.glob(os.path.join(carpeta, "espectroscopia_*.csv"))):
+        df = pd.read_csv(ruta)
+        df["material"] = os.path.basename(ruta).replace("espectroscopia_", "").replace(".csv", "").lower()
+        dfs.append(df)
+    df = pd.concat(dfs, ignore_index=True)
+    return escalador.transform(entradas_modelo(df, columnas)), df["material"].values
+
+
+if __name__ == "__main__":
+    if len(sys.argv) not in (2, 3):
+        sys.exit("Uso: python exportar_modelo.py <modelo.pkl> [carpeta con los CSV de entrenamiento]")
+    datos = joblib.load(sys.argv[1])
+    novedad = datos.get("novedad")
+    if len(sys.argv) == 3:
+        X, y = _leer_datos(sys.argv[2], datos["escalador"])
+        novedad = calcular_novedad(X, y, datos["escalador"])
+    sys.stdout.write(exportar_cabecera(datos["modelo"], datos["escalador"], novedad=novedad,
+                                       nombre=sys.argv[1].replace("\\", "/").split("/")[-1]))
@@ -0,0 +1,36 @@
+#ifndef ACQ_SETTINGS_H
+#define ACQ_SETTINGS_H
+
+// Parámetros de adquisición ajustables en marcha: periodo de muestreo,
+// ganancia, Tint, tramas por mensaje y banda muerta. Llegan como atributos
+// compartidos de ThingsBoard o por el RPC setAcquisition; cada sensor_task
+// los aplica en el límite entre tramas y el primero que lo hace los guarda en
+// NVS y los devuelve como atributos de cliente.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#define ACQ_MAX_BATCH 8  // Tramas por mensaje de telemetría como máximo
+
+typedef struct {
+    uint32_t period_ms;   // Entre el comienzo de dos tramas; 0 = seguidas
+    uint8_t gain;         // 0..3: x1, x3,7, x16, x64 (bits 5:4 de CONFIG_REG)
+    uint8_t tint;         // Tiempo de integración en pasos de 2,8 ms (1..255)
+    uint8_t batch;        // Tramas por mensaje de telemetría (1..ACQ_MAX_BATCH)
+    uint16_t deadband;    // No se publica una trama si ningún canal cambió más de
+                          // estas cuentas desde la última publicada; 0 = todas
+} acq_settings_t;
+
+// Carga los últimos aplicados de NVS (o los de Kconfig), antes de arrancar los cabezales
+void acq_settings_load(void);
+// Valida y pide unos nuevos; ESP_ERR_INVALID_ARG si alguno está fuera de rango
+esp_err_t acq_settings_request(const acq_settings_t *settings);
+// Los pedidos (se aplican en la siguiente trama) y su número de versión
+uint32_t acq_settings_get(acq_settings_t *settings);
+
+// Desde sensor_task, tras aplicar la versión version. Devuelve true solo al
+// primero que la aplica, que es quien la ha guardado en NVS y debe publicarla.
+bool acq_settings_applied(uint32_t version);
+
+#endif // ACQ_SETTINGS_H
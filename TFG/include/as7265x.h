@@ -1,8 +1,8 @@
 #ifndef AS7265X_H
 #define AS7265X_H
 
-#include "driver/i2c.h"
 #include "esp_err.h"
+#include "sample_ring.h"
 
 // Dirección I2C del AS7265x
 #define AS7265X_I2C_ADDR 0x49
@@ -13,11 +13,74 @@
 #define AS7265X_SLAVE_READ_REG    0x02
 #define AS7265X_DATA_START        0x08
 
-// Bit de estado en AS7265X_SLAVE_STATUS_REG
-#define TX_VALID 0x01 // Indica si el dato está listo
+// Bits de estado en AS7265X_SLAVE_STATUS_REG
+#define AS7265X_STATUS_RX_VALID 0x01  // Hay un dato listo en READ
+#define AS7265X_STATUS_TX_VALID 0x02  // El sensor todavía no ha procesado la última escritura
+
+// Corriente del driver de LED de cada dispositivo (registro LED_CONFIG)
+typedef enum {
+    AS7265X_LED_OFF = 0,
+    AS7265X_LED_12_5MA,
+    AS7265X_LED_25MA,
+    AS7265X_LED_50MA,
+    AS7265X_LED_100MA
+} as7265x_led_current_t;
+
+// Dispositivos del AS7265x y el LED que gobierna cada uno
+#define AS7265X_NUM_DEVICES 3  // 0: AS72651 (blanco), 1: AS72652 (IR), 2: AS72653 (UV)
+
+typedef struct {
+    bool interleaved;                                 // Tramas con y sin LED, se publica la diferencia
+    as7265x_led_current_t current[AS7265X_NUM_DEVICES];
+} as7265x_illum_t;
+
+// Máscara de canales: bit i = canal i en orden RSTUVW GHIJKL ABCDEF, así que
+// cada dispositivo ocupa 6 bits consecutivos
+#define AS7265X_ALL_CHANNELS 0x3FFFFu
+#define AS7265X_DEVICE_CHANNELS(dev) (0x3Fu << ((dev) * 6))
+
+// Cabezales de medida (Kconfig AS7265X_HEADS)
+#if CONFIG_AS7265X_HEADS_MUX
+#define AS7265X_NUM_HEADS CONFIG_AS7265X_MUX_HEADS
+#elif CONFIG_AS7265X_HEADS_DUAL_PORT
+#define AS7265X_NUM_HEADS 2
+#else
+#define AS7265X_NUM_HEADS 1
+#endif
+
+// Un AS7265x completo (sus 3 dispositivos) y su estado de adquisición
+typedef struct {
+    uint8_t id;              // Número de cabezal, el que llevan sus tramas
+    uint8_t port;            // Puerto I2C
+    int8_t mux_channel;      // Canal del TCA9548A, o -1 sin multiplexor
+    uint8_t config_reg;      // Registro de configuración (ganancia y modo)
+    uint8_t integration_reg; // Tint programado (pasos de 2,8 ms)
+    uint32_t channel_mask;   // Canales que se leen en cada trama
+} as7265x_head_t;
 
 // Funciones del driver
+// Prepara la tabla de cabezales; cada uno se configura con as7265x_head_init
+// al arrancar su sensor_task
 void as7265x_init();
+esp_err_t as7265x_head_init(as7265x_head_t *head);
+// Libera el bus del cabezal con pulsos de SCL y lo vuelve a configurar
+esp_err_t as7265x_recover(as7265x_head_t *head);
+int as7265x_num_heads(void);
+as7265x_head_t *as7265x_get_head(int id);
 void gpio_init();
 void sensor_task(void *pvParameter);
+// Los errores del protocolo de registros virtuales (ESP_ERR_TIMEOUT si el
+// sensor no responde en AS7265X_VREG_TIMEOUT_MS) llegan al llamante
+esp_err_t as7265x_read_frame(as7265x_head_t *head, sample_frame_t *frame);
+esp_err_t as7265x_read_frame_calibrated(as7265x_head_t *head, sample_frame_t *frame, float calibrated[SAMPLE_CHANNELS]);
+// n tramas seguidas a frames, separadas al menos un Tint; captured: las que
+// se completaron antes de un error
+esp_err_t as7265x_capture_burst(as7265x_head_t *head, sample_frame_t *frames, int n, int *captured);
+// La nueva configuración de iluminación se aplica en la siguiente trama
+void as7265x_set_illumination(const as7265x_illum_t *illum);
+void as7265x_get_illumination(as7265x_illum_t *illum);
+// Igual con la máscara de canales: los dispositivos sin ningún canal en la
+// máscara no se seleccionan ni se leen. ESP_ERR_INVALID_ARG si no queda ninguno.
+esp_err_t as7265x_set_channel_mask(uint32_t mask);
+uint32_t as7265x_get_channel_mask(void);
 #endif // AS7265X_H
@@ -0,0 +1,8 @@
+#ifndef BENCH_QEMU_H
+#define BENCH_QEMU_H
+
+// Arranque del benchmark en QEMU: red Ethernet openeth, MQTT contra el broker
+// local y, pasados CONFIG_BENCH_DURATION_S segundos, informe por UART
+void bench_qemu_start(void);
+
+#endif // BENCH_QEMU_H
@@ -0,0 +1,41 @@
+#ifndef BOOT_H
+#define BOOT_H
+
+// Secuencia de arranque: mapa de dispositivos I2C cacheado en NVS y tiempos
+// de cada fase medidos desde el arranque del temporizador (esp_timer), que
+// se registran en el log y en /metrics.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+typedef enum {
+    BOOT_PHASE_NVS,             // NVS inicializada
+    BOOT_PHASE_I2C,             // Bus(es) I2C configurados y dispositivos localizados
+    BOOT_PHASE_SENSOR,          // Primer cabezal AS7265x configurado
+    BOOT_PHASE_OLED,            // Pantalla inicializada
+    BOOT_PHASE_WIFI,            // IP obtenida (o AP levantado)
+    BOOT_PHASE_MQTT,            // Conectado al broker
+    BOOT_PHASE_FIRST_FRAME,     // Primera trama adquirida
+    BOOT_PHASE_FIRST_TELEMETRY, // PUBACK de la primera telemetría
+    BOOT_PHASE_COUNT
+} boot_phase_t;
+
+// Marca el final de una fase; solo cuenta la primera vez
+void boot_phase_done(boot_phase_t phase);
+// Microsegundos desde el arranque hasta el final de la fase, o -1 si no ha llegado
+int64_t boot_phase_us(boot_phase_t phase);
+const char *boot_phase_name(boot_phase_t phase);
+
+typedef struct {
+    uint8_t port;
+    uint8_t addr;
+} boot_i2c_dev_t;
+
+// Comprueba los dispositivos del bus: solo las direcciones del mapa guardado
+// en NVS o, si no hay mapa, falta alguno de los esperados o alguna dirección
+// no responde, los puertos completos (y guarda el nuevo mapa).
+void boot_probe_i2c(const boot_i2c_dev_t *expected, int num_expected);
+bool boot_device_present(uint8_t port, uint8_t addr);
+
+#endif // BOOT_H
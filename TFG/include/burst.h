@@ -0,0 +1,49 @@
+#ifndef BURST_H
+#define BURST_H
+
+// Ráfaga a RAM: K tramas seguidas de un cabezal en un búfer reservado al
+// arrancar, sin serializar ni publicar entre tramas, y después se publican
+// todas en mensajes acotados (formato por lotes de ThingsBoard, con el mismo
+// "burst"). Se pide por RPC (captureBurst) o por HTTP (POST /api/burst).
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "sample_ring.h"
+
+typedef enum {
+    BURST_IDLE,
+    BURST_PENDING,    // Pedida; sensor_task la empieza en la siguiente trama
+    BURST_CAPTURING,
+    BURST_UPLOADING,
+    BURST_DONE,
+    BURST_FAILED,
+} burst_state_t;
+
+typedef struct {
+    burst_state_t state;
+    uint32_t id;          // Número de ráfaga (desde 1), "burst" en la telemetría
+    int head;
+    int requested;
+    int captured;
+    int64_t duration_us;  // De la primera a la última trama capturada
+} burst_status_t;
+
+// ESP_ERR_INVALID_ARG si el cabezal no existe o frames no está entre 1 y
+// CONFIG_BURST_MAX_FRAMES; ESP_ERR_INVALID_STATE si ya hay una en curso o el
+// cabezal todavía no ha arrancado
+esp_err_t burst_request(int head, int frames);
+void burst_get_status(burst_status_t *status);
+const char *burst_state_name(burst_state_t state);
+
+// Desde sensor_task, al terminar de arrancar el cabezal: desde entonces acepta ráfagas
+void burst_head_running(int head);
+
+// Desde sensor_task: tramas pedidas para el cabezal (0 si no hay ráfaga
+// pendiente), el búfer donde capturarlas y el resultado de cada fase
+int burst_take(int head, uint32_t *id);
+sample_frame_t *burst_buffer(void);
+void burst_captured(int captured, int64_t duration_us);
+void burst_uploaded(bool ok);
+
+#endif // BURST_H
@@ -0,0 +1,52 @@
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+// Calibración de reflectancia con referencias oscura y blanca. Cada referencia
+// es la media de N tramas y se guarda en NVS para el cabezal y la combinación
+// de ganancia y tiempo de integración con la que se capturó. La reflectancia por canal,
+// (raw - oscura) / (blanca - oscura), se entrega en punto fijo.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "sample_ring.h"
+#include "as7265x.h"
+
+#define REFLECTANCE_SCALE 10000  // Reflectancia 1.0 = 10000
+
+typedef enum {
+    CAL_REF_DARK,
+    CAL_REF_WHITE,
+    CAL_REF_COUNT
+} cal_ref_kind_t;
+
+typedef struct {
+    uint8_t gain;           // Bits de ganancia del registro de configuración (0..3)
+    uint8_t tint;           // Registro de tiempo de integración
+    bool valid[CAL_REF_COUNT];
+    int capturing;          // cal_ref_kind_t en captura, o -1
+    int remaining;          // Tramas que faltan para terminar la captura
+} calibration_status_t;
+
+// Tramas de una referencia como mucho, el máximo de CONFIG_CALIBRATION_FRAMES:
+// la suma de cada canal (uint32_t) no puede desbordarse
+#define CALIBRATION_MAX_FRAMES 256
+
+// Captura de una referencia con las próximas frames tramas (0 = valor de
+// Kconfig, hasta CALIBRATION_MAX_FRAMES). ESP_ERR_INVALID_ARG fuera de rango,
+// ESP_ERR_INVALID_STATE si ya hay una captura en curso.
+esp_err_t calibration_request(int head, cal_ref_kind_t kind, int frames);
+// Borra las referencias de la ganancia y Tint actuales (RAM y NVS)
+esp_err_t calibration_clear(int head);
+// ESP_ERR_INVALID_ARG si el cabezal no existe
+esp_err_t calibration_get_status(int head, calibration_status_t *status);
+
+// Desde sensor_task, con cada trama (de cualquier cabezal, frame->head) y los
+// registros de configuración y Tint con los que se adquirió
+void calibration_process_frame(const sample_frame_t *frame, uint8_t config, uint8_t tint);
+
+// Reflectancia en unidades de 1/REFLECTANCE_SCALE. Devuelve false si falta
+// alguna referencia para la configuración actual.
+bool calibration_apply(int head, const uint16_t raw[SAMPLE_CHANNELS], uint16_t reflectance[SAMPLE_CHANNELS]);
+
+#endif // CALIBRATION_H
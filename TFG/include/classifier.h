@@ -0,0 +1,42 @@
+#ifndef CLASSIFIER_H
+#define CLASSIFIER_H
+
+// Clasificación del material en la placa con el bosque aleatorio exportado
+// desde app.py (main/classifier_model.h). Delante hay una caché LRU por
+// cabezal: una trama que, cuantizada a CONFIG_CLASSIFIER_CACHE_BITS bits por
+// canal, coincide con una reciente reutiliza su material y confianza sin
+// recorrer los árboles.
+//
+// Con CONFIG_CLASSIFIER_NOVELTY, cada trama se compara además con la
+// distribución de entrenamiento del material predicho (distancia de
+// Mahalanobis, media y covarianza exportadas con el bosque): si la supera,
+// frame->novel marca que el material probablemente no es ninguno de los
+// conocidos.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sample_ring.h"
+
+// Nodo del bosque. Los umbrales están en cuentas crudas (o en las unidades en
+// punto fijo de la característica): app.py deshace el StandardScaler al
+// exportar.
+typedef struct {
+    int16_t channel;     // Entrada: 0-17 canal (orden RSTUVW GHIJKL ABCDEF),
+                         // 18 + i característica i (spectral.h); -1 en las hojas
+    int32_t threshold;   // Se va a left si el valor es <= threshold
+    uint16_t left;       // En las hojas, la fila de sus probabilidades
+    uint16_t right;
+} model_node_t;
+
+// Desde sensor_task: rellena frame->label, frame->confidence, frame->novel y frame->distance
+void classifier_classify(sample_frame_t *frame);
+// Inferencia sin caché (banco de pruebas)
+void classifier_run(const sample_frame_t *frame, int8_t *label, uint8_t *confidence);
+// Distancia de Mahalanobis de la trama al material label (x16, saturada a
+// 65535) y si supera el umbral de ese material; distancia 0 si el modelo no
+// trae detector de novedad
+uint16_t classifier_novelty(const sample_frame_t *frame, int label, bool *novel);
+int classifier_num_labels(void);
+const char *classifier_label_name(int label);
+
+#endif // CLASSIFIER_H
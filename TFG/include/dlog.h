@@ -0,0 +1,62 @@
+#ifndef DLOG_H
+#define DLOG_H
+
+// Log del camino crítico (adquisición y publicación). Los mensajes por encima
+// de CONFIG_DLOG_LEVEL desaparecen al compilar. Los que quedan se guardan como
+// registros binarios (ID de formato + argumentos) en un anillo en RAM, sin
+// formatear ni tocar la UART; el texto se reconstruye en el PC con
+// tools/dlog_decode.py. Con CONFIG_DLOG_DEFERRED desactivado se imprimen al
+// momento por consola, como antes.
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "dlog_formats.h"
+
+#define DLOG_LEVEL_ERROR 1
+#define DLOG_LEVEL_WARN  2
+#define DLOG_LEVEL_INFO  3
+#define DLOG_LEVEL_DEBUG 4
+
+#define DLOG_MAX_ARGS 8
+
+#define DLOG_ENUM(id, fmt) id,
+typedef enum {
+    DLOG_FORMATS(DLOG_ENUM)
+    DLOG_FORMAT_COUNT
+} dlog_format_id_t;
+#undef DLOG_ENUM
+
+typedef struct {
+    uint32_t ts_us;   // esp_timer_get_time() truncado a 32 bits
+    uint16_t id;      // dlog_format_id_t
+    uint8_t level;
+    uint8_t nargs;
+    uint32_t args[DLOG_MAX_ARGS];
+} dlog_record_t;
+
+// Volcado binario (little-endian): "SPLG", u16 versión, u16 tamaño de registro,
+// u32 número de registros y los registros del más antiguo al más reciente
+#define DLOG_MAGIC   "SPLG"
+#define DLOG_VERSION 1
+
+void dlog_write(uint8_t level, uint16_t id, uint8_t nargs, const uint32_t *args);
+
+// DLOG(DLOG_LEVEL_INFO, DLOG_TELEMETRY_SENT, msg_id, len): como mucho
+// DLOG_MAX_ARGS argumentos enteros. La condición es constante, así que por
+// encima del nivel configurado el compilador elimina la llamada entera.
+#define DLOG(level, id, ...) do {                                                   \
+        if ((level) <= CONFIG_DLOG_LEVEL) {                                         \
+            const uint32_t dlog_args_[] = { 0, ##__VA_ARGS__ };                     \
+            _Static_assert(sizeof(dlog_args_) / sizeof(uint32_t) <= DLOG_MAX_ARGS + 1, \
+                           "demasiados argumentos para DLOG");                      \
+            dlog_write((level), (id), sizeof(dlog_args_) / sizeof(uint32_t) - 1,    \
+                       dlog_args_ + 1);                                             \
+        }                                                                           \
+    } while (0)
+
+typedef esp_err_t (*dlog_sink_t)(void *ctx, const char *data, size_t len);
+esp_err_t dlog_dump(dlog_sink_t sink, void *ctx);
+void dlog_dump_uart(void);
+
+#endif // DLOG_H
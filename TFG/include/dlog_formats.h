@@ -0,0 +1,15 @@
+#ifndef DLOG_FORMATS_H
+#define DLOG_FORMATS_H
+
+// Tabla de formatos del log diferido: X(identificador, formato). El orden
+// define el ID que se guarda en cada registro, así que solo se añaden
+// entradas al final. tools/dlog_decode.py lee este fichero para decodificar.
+// Los argumentos son enteros de 32 bits: nada de %s ni de punteros.
+#define DLOG_FORMATS(X) \
+    X(DLOG_SENSOR_VALUES,   "Sensor %u: %u, %u, %u, %u, %u, %u") \
+    X(DLOG_TEMPERATURE,     "Temperatura del sensor: %d C") \
+    X(DLOG_SENSOR_CONFIG,   "Tint: %u, Gain: %u") \
+    X(DLOG_TELEMETRY_SENT,  "Telemetria enviada: msg_id %d, %u bytes") \
+    X(DLOG_PUBLISH_FAILED,  "Error al publicar la telemetria: %d")
+
+#endif // DLOG_FORMATS_H
@@ -0,0 +1,23 @@
+#ifndef DRIFT_H
+#define DRIFT_H
+
+// Compensación de la deriva térmica de cada canal. Modelo lineal alrededor de
+// la temperatura de referencia, raw(T) = raw(Tref) * (1 + k * (T - Tref)), con
+// k en ppm/°C y la temperatura del propio dispositivo de cada canal. Los
+// coeficientes se guardan en NVS; con todos a 0 la etapa no hace nada.
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "sample_ring.h"
+
+#define DRIFT_PPM 1000000
+
+// Sustituye y guarda en NVS la temperatura de referencia y los coeficientes
+esp_err_t drift_set(int tref, const int32_t k_ppm[SAMPLE_CHANNELS]);
+void drift_get(int *tref, int32_t k_ppm[SAMPLE_CHANNELS]);
+
+// Desde sensor_task, antes de publicar: corrige frame->values a la
+// temperatura de referencia usando frame->die_temperature
+void drift_compensate(sample_frame_t *frame);
+
+#endif // DRIFT_H
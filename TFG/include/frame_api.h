@@ -0,0 +1,8 @@
+#ifndef FRAME_API_H
+#define FRAME_API_H
+
+#include "esp_http_server.h"
+
+esp_err_t frame_api_register(httpd_handle_t server);
+
+#endif // FRAME_API_H
@@ -0,0 +1,52 @@
+#ifndef HAL_H
+#define HAL_H
+
+// Capa de abstracción del hardware usada por as7265x.c, oled.c y
+// thingsboard_control.c. En el ESP32 la implementa hal_esp32.c; al compilar
+// para el target linux la sustituye main/host/hal_sim.c (AS7265x simulado y
+// MQTT en memoria), de modo que el pipeline se puede ejecutar en el PC.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+// Bus I2C (port: 0 = I2C_NUM_0, 1 = I2C_NUM_1). Con len 0, hal_i2c_write
+// envía solo reg (p. ej. el byte de control del multiplexor TCA9548A).
+#define HAL_I2C_PORTS 2
+
+esp_err_t hal_i2c_init(uint8_t port, int sda_io, int scl_io, uint32_t freq_hz);
+esp_err_t hal_i2c_read_reg(uint8_t port, uint8_t addr, uint8_t reg, uint8_t *data);
+esp_err_t hal_i2c_write(uint8_t port, uint8_t addr, uint8_t reg, const uint8_t *data, size_t len);
+// ESP_OK si algún dispositivo reconoce (ACK) la dirección
+esp_err_t hal_i2c_probe(uint8_t port, uint8_t addr, uint32_t timeout_ms);
+// Libera un bus bloqueado (esclavo reteniendo SDA) con pulsos de SCL y una
+// condición de STOP, y deja el puerto listo para volver a usarse
+esp_err_t hal_i2c_bus_recover(uint8_t port);
+
+// Entrada de disparo externo: cb se llama desde la ISR del flanco con su
+// marca de tiempo (esp_timer_get_time)
+typedef void (*hal_trigger_cb_t)(int64_t edge_us);
+esp_err_t hal_trigger_init(int gpio, bool rising_edge, hal_trigger_cb_t cb);
+
+// LED de estado
+void hal_led_init(void);
+void hal_led_set_level(uint32_t level);
+
+// Transporte MQTT
+typedef void (*hal_mqtt_connection_cb_t)(bool connected);
+typedef void (*hal_mqtt_data_cb_t)(const char *topic, int topic_len, const char *data, int data_len);
+typedef void (*hal_mqtt_published_cb_t)(int msg_id);  // PUBACK de un mensaje QoS 1
+
+void hal_mqtt_start(const char *uri, const char *username, hal_mqtt_connection_cb_t on_connection,
+                    hal_mqtt_data_cb_t on_data, hal_mqtt_published_cb_t on_published);
+int hal_mqtt_publish(const char *topic, const char *data, int len, int qos);
+int hal_mqtt_subscribe(const char *topic, int qos);
+int hal_mqtt_outbox_size(void);
+
+// Hora de pared: SNTP se arranca al tener red (llamarla otra vez no hace nada)
+// y hasta la primera sincronización gettimeofday cuenta desde 1970
+void hal_time_sync_start(void);
+bool hal_time_synced(void);
+
+#endif // HAL_H
@@ -0,0 +1,20 @@
+#ifndef HEAP_GUARD_H
+#define HEAP_GUARD_H
+
+// Comprobación en depuración de que el bucle de adquisición y publicación no
+// reserva memoria dinámica una vez pasado el calentamiento. Con
+// CONFIG_HEAP_GUARD, cualquier malloc desde una tarea vigilada aborta con un
+// mensaje que indica el tamaño pedido. Cada tarea se arma por separado y lleva
+// su propia cuenta de ventanas permitidas.
+
+#if CONFIG_HEAP_GUARD
+void heap_guard_arm(void);            // Empieza a vigilar la tarea actual
+void heap_guard_allow_begin(void);    // Reservas propias de una librería (outbox MQTT)
+void heap_guard_allow_end(void);
+#else
+static inline void heap_guard_arm(void) {}
+static inline void heap_guard_allow_begin(void) {}
+static inline void heap_guard_allow_end(void) {}
+#endif
+
+#endif // HEAP_GUARD_H
@@ -0,0 +1,57 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_timer.h"
+
+// Histogramas de latencia (microsegundos)
+typedef enum {
+    METRIC_HIST_I2C_AS7265X,    // Transacción I2C con el AS7265x
+    METRIC_HIST_I2C_SSD1306,    // Transacción I2C con la pantalla
+    METRIC_HIST_FRAME_ACQ,      // Adquisición de una trama completa
+    METRIC_HIST_SERIALIZE,      // Construcción del JSON de telemetría
+    METRIC_HIST_PUBLISH,        // Llamada a esp_mqtt_client_publish
+    METRIC_HIST_PUBACK,         // Desde el inicio de la adquisición hasta el PUBACK del broker
+    METRIC_HIST_TRIGGER,        // Desde el flanco de disparo hasta la primera trama de la ráfaga
+    METRIC_HIST_CLASSIFY,       // Clasificación de una trama (caché o bosque)
+    METRIC_HIST_COUNT
+} metric_hist_t;
+
+// Contadores monótonos
+typedef enum {
+    METRIC_FRAMES_ACQUIRED,
+    METRIC_FRAMES_PUBLISHED,
+    METRIC_FRAMES_ACKED,
+    METRIC_PUBLISH_ERRORS,
+    METRIC_I2C_ERRORS,
+    METRIC_WS_FRAMES_DROPPED,
+    METRIC_VREG_TIMEOUTS,
+    METRIC_BUS_RECOVERIES,
+    METRIC_TRIGGERS,
+    METRIC_TRIGGERS_MISSED,
+    METRIC_TRIGGER_OVERRUNS,
+    METRIC_FRAMES_DEADBAND,
+    METRIC_CLASSIFIER_CACHE_HITS,
+    METRIC_CLASSIFIER_CACHE_MISSES,
+    METRIC_NOVEL_FRAMES,
+    METRIC_MQTT_FRAMES_DROPPED,
+    METRIC_COUNTER_COUNT
+} metric_counter_t;
+
+void metrics_count(metric_counter_t counter, uint32_t n);
+void metrics_observe_us(metric_hist_t hist, uint32_t us);
+uint32_t metrics_get_counter(metric_counter_t counter);
+void metrics_get_hist(metric_hist_t hist, uint32_t *count, uint64_t *sum_us);
+
+// Destino de la exposición en texto (bloque HTTP chunked, stdout...)
+typedef esp_err_t (*metrics_sink_t)(void *ctx, const char *data, size_t len);
+esp_err_t metrics_write_prometheus(metrics_sink_t sink, void *ctx);
+
+// Mide el tiempo transcurrido desde start (esp_timer_get_time) en un histograma
+static inline void metrics_observe_since(metric_hist_t hist, int64_t start) {
+    metrics_observe_us(hist, (uint32_t)(esp_timer_get_time() - start));
+}
+
+#endif // METRICS_H
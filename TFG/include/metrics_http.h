@@ -0,0 +1,8 @@
+#ifndef METRICS_HTTP_H
+#define METRICS_HTTP_H
+
+#include "esp_http_server.h"
+
+esp_err_t metrics_register(httpd_handle_t server);
+
+#endif // METRICS_HTTP_H
@@ -0,0 +1,62 @@
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Número de canales por trama (3 sensores x 6 canales)
+#define SAMPLE_CHANNELS 18
+#define SAMPLE_DEVICES 3
+
+// Tamaño de una trama serializada en binario (little-endian):
+// seq (u32) | timestamp_ms (i64) | temperatura (i16) | 18 canales (u16) | cabezal (u8)
+#define SAMPLE_FRAME_WIRE_SIZE (4 + 8 + 2 + SAMPLE_CHANNELS * 2 + 1)
+
+// Trama adquirida del AS7265x. Canales en orden RSTUVW GHIJKL ABCDEF.
+typedef struct {
+    int64_t timestamp_ms;             // Hora de adquisición (ms desde epoch)
+    int64_t acquired_us;              // esp_timer_get_time() al comenzar la adquisición (latencia hasta el PUBACK)
+    uint32_t seq;                     // Número de secuencia (lo asigna el anillo)
+    int16_t temperature;              // Temperatura media de los 3 dispositivos en °C
+    int16_t die_temperature[SAMPLE_DEVICES]; // Temperatura de cada dispositivo (orden de DEV_SEL)
+    uint8_t head;                     // Cabezal que la adquirió
+    int8_t label;                     // Material según el clasificador de la placa, -1 sin clasificar
+    uint8_t confidence;               // Probabilidad de ese material (x255)
+    uint8_t novel;                    // 1 si queda fuera de la distribución de ese material
+    uint32_t channel_mask;            // Canales leídos (bit i: values[i]); el resto vale 0
+    uint32_t trigger_id;              // Disparo externo que originó la trama, 0 en muestreo libre
+    uint32_t burst_id;                // Ráfaga a RAM a la que pertenece, 0 fuera de ráfaga
+    uint16_t values[SAMPLE_CHANNELS]; // Valores crudos de los canales
+    uint16_t distance;                // Distancia de Mahalanobis a ese material (x16), 0 sin detector
+#if CONFIG_AS7265X_CALIBRATED_READOUT
+    float calibrated[SAMPLE_CHANNELS]; // Valores calibrados de fábrica, mismo orden que values
+#endif
+} sample_frame_t;
+
+// Tramas que pueden estar retenidas a la vez por lectores (sample_ring_acquire);
+// cada lector retiene una como mucho
+#define SAMPLE_RING_MAX_HELD 8
+
+// Lector del bus de tramas con su propio cursor
+typedef struct {
+    uint32_t cursor;   // Secuencia de la próxima trama a leer
+    uint32_t dropped;  // Tramas que el anillo expulsó antes de que se leyeran
+} sample_ring_sub_t;
+
+void sample_ring_init(void);
+uint32_t sample_ring_push(sample_frame_t *frame);
+const sample_frame_t *sample_ring_acquire(uint32_t seq);
+void sample_ring_release(const sample_frame_t *frame);
+bool sample_ring_subscribe(sample_ring_sub_t *sub, TaskHandle_t task);
+const sample_frame_t *sample_ring_next(sample_ring_sub_t *sub);
+uint32_t sample_ring_next_seq(void);
+uint32_t sample_ring_oldest_seq(void);
+uint32_t sample_ring_find_after(int64_t timestamp_ms);
+void sample_ring_get_stats(uint32_t *fill, uint32_t *overwritten, uint32_t *held);
+bool sample_ring_add_listener(TaskHandle_t task);
+size_t sample_frame_pack(const sample_frame_t *frame, uint8_t *out);
+
+#endif // SAMPLE_RING_H
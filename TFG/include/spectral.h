@@ -0,0 +1,62 @@
+#ifndef SPECTRAL_H
+#define SPECTRAL_H
+
+// Etapa de características espectrales en punto fijo, a partir de los 18
+// canales crudos ordenados por longitud de onda (A B C D E F G H R I S J T U
+// V W K L, de 410 a 940 nm):
+// - Espectro normalizado por área (suma 1) y por norma euclídea (norma 1),
+//   en Q14 (16384 = 1,0).
+// - Primera derivada: diferencia entre bandas contiguas del espectro
+//   normalizado por área, en Q14.
+// - Cocientes entre pares de canales, en Q8 (256 = 1,0) saturado a 65535.
+// Las operaciones vectoriales usan las rutinas s16 de esp-dsp. Machine
+// Learning/caracteristicas.py repite las mismas cuentas entero a entero para
+// entrenar con ellas, y se publican con los mismos nombres: "A_a", "A_v",
+// "A_d" (de A a B) y "W/R".
+
+#include <stdint.h>
+
+#define SPECTRAL_BANDS 18
+#define SPECTRAL_MAX_RATIOS 8
+
+// Posición de cada grupo en el vector de spectral_get
+#define SPECTRAL_DERIVATIVE 0
+#define SPECTRAL_AREA       (SPECTRAL_DERIVATIVE + SPECTRAL_BANDS - 1)
+#define SPECTRAL_VECTOR     (SPECTRAL_AREA + SPECTRAL_BANDS)
+#define SPECTRAL_RATIOS     (SPECTRAL_VECTOR + SPECTRAL_BANDS)
+#define SPECTRAL_LEN       (SPECTRAL_RATIOS + SPECTRAL_MAX_RATIOS)
+
+// Cociente values[num] / values[den] (canales en orden RSTUVW GHIJKL ABCDEF)
+typedef struct {
+    uint8_t num;
+    uint8_t den;
+} spectral_ratio_t;
+
+typedef struct {
+    int16_t derivative[SPECTRAL_BANDS - 1];
+    int16_t area[SPECTRAL_BANDS];
+    int16_t vector[SPECTRAL_BANDS];
+    uint16_t ratios[SPECTRAL_MAX_RATIOS];
+} spectral_features_t;
+
+// Interpreta CONFIG_SPECTRAL_RATIOS ("W/R,L/G,...") para la telemetría
+void spectral_init(void);
+
+// Calcula todas las características de una trama; ratios puede ser NULL si
+// num_ratios es 0
+void spectral_compute(const uint16_t values[SPECTRAL_BANDS], const spectral_ratio_t *ratios, int num_ratios,
+                      spectral_features_t *out);
+// Elemento index del vector (SPECTRAL_DERIVATIVE + i, SPECTRAL_AREA + i...)
+int32_t spectral_get(const spectral_features_t *features, int index);
+
+// Pares de CONFIG_SPECTRAL_RATIOS que publica la telemetría
+const spectral_ratio_t *spectral_telemetry_ratios(int *num_ratios);
+// Letra del canal i (orden RSTUVW GHIJKL ABCDEF) y canal de la banda i
+// (orden de longitud de onda)
+char spectral_channel_name(int channel);
+int spectral_band_channel(int band);
+
+// Raíz cuadrada entera (por defecto)
+uint32_t spectral_isqrt(uint64_t x);
+
+#endif // SPECTRAL_H
@@ -1,5 +1,17 @@
 #ifndef THINGSBOARD_CONTROL_H
 #define THINGSBOARD_CONTROL_H
-void send_data_to_thingsboard_mqtt(uint16_t values[18], int temperature);
+#include <stdint.h>
+#include <stdbool.h>
+#include "sample_ring.h"
+#include "acq_settings.h"
+void send_data_to_thingsboard_mqtt(const sample_frame_t *frame, const float *calibrated, int64_t acquired_us);
+// Tarea que publica las tramas del anillo de muestras a medida que llegan
+void thingsboard_publisher_start(void);
+// Las n tramas de una ráfaga en mensajes de varias [{"ts":..,"values":{..}},..]
+// o, sin hora de SNTP, de una en una sin "ts"
+bool send_burst_to_thingsboard_mqtt(const sample_frame_t *frames, int n, uint32_t burst_id);
+// Parámetros de adquisición aplicados, como atributos de cliente
+void thingsboard_report_settings(const acq_settings_t *settings);
 void mqtt_app_start();
+int thingsboard_outbox_size();
 #endif
\ No newline at end of file
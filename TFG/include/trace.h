@@ -0,0 +1,58 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Puntos de traza de las etapas del pipeline. Cada evento (8 bytes) se guarda
+// tal cual en un anillo por núcleo, sin formatear nada en el camino crítico.
+// El anillo se vuelca en binario por HTTP (/trace.bin) o en hexadecimal por
+// UART, y tools/trace_to_chrome.py lo convierte al formato JSON de Chrome
+// (chrome://tracing, Perfetto).
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+typedef enum {
+    TRACE_DEV_SELECT = 1,    // Selección de dispositivo (arg: sensor)
+    TRACE_VREG_READ,         // Lectura de un registro virtual (arg: registro)
+    TRACE_FRAME_COMPLETE,    // Trama de 18 canales completa
+    TRACE_SERIALIZE,         // Construcción del JSON de telemetría
+    TRACE_PUBLISH,           // Encolado en el cliente MQTT (arg al terminar: msg_id)
+    TRACE_PUBACK,            // PUBACK del broker (arg: msg_id)
+    TRACE_HUD_FLUSH,         // Escritura de una línea del HUD (arg: página)
+} trace_event_id_t;
+
+#define TRACE_PHASE_BEGIN   'B'
+#define TRACE_PHASE_END     'E'
+#define TRACE_PHASE_INSTANT 'i'
+
+typedef struct {
+    uint32_t ts_us;   // esp_timer_get_time() truncado a 32 bits (da la vuelta cada ~71 min)
+    uint8_t event;
+    uint8_t phase;
+    uint16_t arg;
+} trace_event_t;
+
+// Volcado binario (little-endian): cabecera "SPTR", u16 versión, u16 núcleos,
+// y por cada núcleo un u32 con el número de eventos seguido de los eventos,
+// del más antiguo al más reciente
+#define TRACE_MAGIC   "SPTR"
+#define TRACE_VERSION 1
+
+typedef esp_err_t (*trace_sink_t)(void *ctx, const char *data, size_t len);
+
+#if CONFIG_TRACE_ENABLED
+void trace_record(uint8_t event, uint8_t phase, uint16_t arg);
+#define TRACE_BEGIN(event, arg)   trace_record((event), TRACE_PHASE_BEGIN, (arg))
+#define TRACE_END(event, arg)     trace_record((event), TRACE_PHASE_END, (arg))
+#define TRACE_INSTANT(event, arg) trace_record((event), TRACE_PHASE_INSTANT, (arg))
+#else
+#define TRACE_BEGIN(event, arg)   ((void)0)
+#define TRACE_END(event, arg)     ((void)0)
+#define TRACE_INSTANT(event, arg) ((void)0)
+#endif
+
+// Devuelve ESP_ERR_NOT_SUPPORTED si las trazas están desactivadas en Kconfig
+esp_err_t trace_dump(trace_sink_t sink, void *ctx);
+void trace_dump_uart(void);
+
+#endif // TRACE_H
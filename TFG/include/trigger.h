@@ -0,0 +1,29 @@
+#ifndef TRIGGER_H
+#define TRIGGER_H
+
+// Disparo externo (p. ej. la fotocélula de una cinta): un flanco en
+// CONFIG_TRIGGER_GPIO hace que cada sensor_task capture una ráfaga de
+// CONFIG_TRIGGER_BURST_FRAMES tramas en lugar del muestreo libre cada segundo.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+typedef struct {
+    uint32_t id;      // Número de disparo (desde 1); lo llevan las tramas de la ráfaga
+    int64_t edge_us;  // esp_timer_get_time() del flanco, tomado en la ISR
+} trigger_event_t;
+
+// Configura la entrada y su interrupción (sin efecto sin CONFIG_TRIGGER_ENABLED)
+void trigger_init(void);
+// Registra la tarea que llama como destinataria de los disparos; devuelve su
+// ranura para trigger_wait o -1 si no quedan
+int trigger_add_sampler(void);
+// Espera al siguiente disparo de la ranura. Hasta trigger_burst_done, los
+// flancos que lleguen se descartan y cuentan en spectrometer_trigger_overruns_total.
+bool trigger_wait(int slot, trigger_event_t *event, TickType_t timeout);
+// Fin de la ráfaga del último disparo: la ranura vuelve a aceptar flancos
+void trigger_burst_done(int slot);
+
+#endif // TRIGGER_H
@@ -0,0 +1,10 @@
+#ifndef WS_STREAM_H
+#define WS_STREAM_H
+
+#include "esp_http_server.h"
+
+esp_err_t ws_stream_register(httpd_handle_t server);
+// La sesión de httpd con ese socket se ha cerrado: deja de enviarle tramas
+void ws_stream_session_closed(int fd);
+
+#endif // WS_STREAM_H
@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "nvs.h"
+#include "heap_guard.h"
+#include "acq_settings.h"
+
+static const char *TAG = "acq_settings";
+
+#define NVS_NAMESPACE "acq"
+#define NVS_KEY       "settings"
+
+static acq_settings_t requested = {
+    .period_ms = CONFIG_ACQ_PERIOD_MS,
+    .gain = CONFIG_ACQ_GAIN,
+    .tint = CONFIG_ACQ_TINT,
+    .batch = CONFIG_ACQ_BATCH,
+    .deadband = CONFIG_ACQ_DEADBAND,
+};
+static uint32_t version = 1;
+static uint32_t stored_version = 1;  // Última versión guardada en NVS
+static portMUX_TYPE settings_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static bool settings_valid(const acq_settings_t *s) {
+    return s->period_ms <= 3600000 && s->gain <= 3 && s->tint >= 1 && s->batch >= 1 && s->batch <= ACQ_MAX_BATCH;
+}
+
+static bool settings_equal(const acq_settings_t *a, const acq_settings_t *b) {
+    return a->period_ms == b->period_ms && a->gain == b->gain && a->tint == b->tint && a->batch == b->batch &&
+           a->deadband == b->deadband;
+}
+
+void acq_settings_load(void) {
+    acq_settings_t stored;
+    size_t size = sizeof(stored);
+    nvs_handle_t nvs;
+
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK) {
+        return;
+    }
+    if (nvs_get_blob(nvs, NVS_KEY, &stored, &size) == ESP_OK && size == sizeof(stored) && settings_valid(&stored)) {
+        portENTER_CRITICAL(&settings_lock);
+        requested = stored;
+        portEXIT_CRITICAL(&settings_lock);
+        ESP_LOGI(TAG, "Parámetros cargados: periodo %" PRIu32 " ms, ganancia %u, Tint %u, lote %u, banda muerta %u",
+                 stored.period_ms, stored.gain, stored.tint, stored.batch, stored.deadband);
+    }
+    nvs_close(nvs);
+}
+
+esp_err_t acq_settings_request(const acq_settings_t *settings) {
+    if (!settings_valid(settings)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // Los mismos que ya hay (otro atributo compartido que cambia) no cuentan como nuevos
+    portENTER_CRITICAL(&settings_lock);
+    if (!settings_equal(settings, &requested)) {
+        requested = *settings;
+        version++;
+    }
+    portEXIT_CRITICAL(&settings_lock);
+    return ESP_OK;
+}
+
+uint32_t acq_settings_get(acq_settings_t *settings) {
+    portENTER_CRITICAL(&settings_lock);
+    *settings = requested;
+    uint32_t v = version;
+    portEXIT_CRITICAL(&settings_lock);
+    return v;
+}
+
+bool acq_settings_applied(uint32_t applied) {
+    acq_settings_t s;
+    nvs_handle_t nvs;
+    bool first = false;
+
+    portENTER_CRITICAL(&settings_lock);
+    // Si ya hay otra pedida, esa se guardará cuando se aplique
+    if (applied == version && stored_version != version) {
+        stored_version = version;
+        s = requested;
+        first = true;
+    }
+    portEXIT_CRITICAL(&settings_lock);
+    if (!first) {
+        return false;
+    }
+
+    // Fuera del régimen normal del bucle: NVS puede reservar memoria
+    heap_guard_allow_begin();
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(nvs, NVS_KEY, &s, sizeof(s));
+        if (err == ESP_OK) {
+            err = nvs_commit(nvs);
+        }
+        nvs_close(nvs);
+    }
+    heap_guard_allow_end();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "No se pudieron guardar los parámetros: %s", esp_err_to_name(err));
+    }
+    return true;
+}
@@ -1,16 +1,34 @@
 #include <stdio.h>
 #include <stdint.h>
-#include "driver/i2c.h"
+#include <string.h>
+#include <inttypes.h>
+#include <sys/time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
+#include "hal.h"
+#include "as7265x.h"
 #include "thingsboard_control.h"
 #include "oled.h"
+#include "sample_ring.h"
+#include "metrics.h"
+#include "trace.h"
+#include "dlog.h"
+#include "heap_guard.h"
+#include "calibration.h"
+#include "drift.h"
+#include "boot.h"
+#include "nvs.h"
+#include "trigger.h"
+#include "burst.h"
+#include "acq_settings.h"
+#include "classifier.h"
 
-#define I2C_MASTER_SCL_IO 22          // GPIO para SCL
-#define I2C_MASTER_SDA_IO 21          // GPIO para SDA
-#define I2C_MASTER_NUM I2C_NUM_0      // Puerto I2C
-#define I2C_MASTER_FREQ_HZ 100000     // Frecuencia I2C
 #define AS7263_ADDR 0x49              // Dirección I2C del AS7263
 
+static const char *TAG = "as7265x";
+
 // Registros del AS7263
 #define I2C_AS72XX_SLAVE_STATUS_REG 0x00
 #define I2C_AS72XX_SLAVE_WRITE_REG  0x01
@@ -19,6 +37,18 @@
 // Registro para la temperatura
 #define VIRTUAL_REG_DEVICE_TEMP 0x06
 #define CONFIG_REG 0x04  // Registro de configuración
+#define INTEGRATION_REG 0x05
+// CONFIG_REG: bits 5:4 ganancia, bits 3:2 modo (2: los 6 canales en continuo)
+#define CONFIG_GAIN_SHIFT 4
+#define CONFIG_MODE_CONTINUOUS 0x08
+#define CONFIG_GAIN_MODE_MASK 0x3C
+#define LED_CONFIG_REG 0x07
+#define RAW_DATA_REG 0x08         // 6 canales x 2 bytes (alto, bajo)
+#define CALIBRATED_DATA_REG 0x14  // 6 canales x float de 4 bytes (big-endian)
+
+// LED_CONFIG: bit 3 habilita el driver, bits 5:4 su corriente (12,5/25/50/100 mA)
+#define LED_DRV_ENABLE 0x08
+#define LED_DRV_CURRENT_SHIFT 4
 
 // Registro para seleccionar el sensor activo
 #define DEV_SEL_REG 0x4F
@@ -30,174 +60,821 @@ typedef enum {
     SENSOR_3 = 0x02   // ABCDEF
 } sensor_t;
 
-// Función para leer un registro de un dispositivo I2C
-esp_err_t i2c_master_read_slave_reg(uint8_t reg_addr, uint8_t *data) {
-    esp_err_t ret;
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (AS7263_ADDR << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd, reg_addr, true);
-    i2c_master_stop(cmd);
-    ret = i2c_master_cmd_begin(I2C_MASTER_NUM, cmd, pdMS_TO_TICKS(1000));
-    i2c_cmd_link_delete(cmd);
-    if (ret != ESP_OK) {
-        return ret;
+// Cabezales: en I2C_NUM_0, tras los canales 0..N-1 del multiplexor, o uno
+// en cada puerto
+static as7265x_head_t heads[AS7265X_NUM_HEADS];
+
+// Cada transacción toma el puerto y, con multiplexor, selecciona antes el
+// canal del cabezal si no es el último usado. Entre transacciones el bus
+// queda libre: los cabezales de un mismo puerto se intercalan (uno lee
+// mientras otro espera la integración) y los de puertos distintos van en paralelo.
+static SemaphoreHandle_t port_locks[HAL_I2C_PORTS];
+static int8_t port_mux_channel[HAL_I2C_PORTS] = { -1, -1 };
+
+static esp_err_t bus_acquire(as7265x_head_t *head) {
+    xSemaphoreTake(port_locks[head->port], portMAX_DELAY);
+#if CONFIG_AS7265X_HEADS_MUX
+    if (port_mux_channel[head->port] != head->mux_channel) {
+        esp_err_t ret = hal_i2c_write(head->port, CONFIG_AS7265X_MUX_ADDR, 1 << head->mux_channel, NULL, 0);
+        if (ret != ESP_OK) {
+            port_mux_channel[head->port] = -1;
+            xSemaphoreGive(port_locks[head->port]);
+            return ret;
+        }
+        port_mux_channel[head->port] = head->mux_channel;
     }
+#endif
+    return ESP_OK;
+}
 
-    cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (AS7263_ADDR << 1) | I2C_MASTER_READ, true);
-    i2c_master_read_byte(cmd, data, I2C_MASTER_NACK);
-    i2c_master_stop(cmd);
-    ret = i2c_master_cmd_begin(I2C_MASTER_NUM, cmd, pdMS_TO_TICKS(1000));
-    i2c_cmd_link_delete(cmd);
+static void bus_release(as7265x_head_t *head) {
+    xSemaphoreGive(port_locks[head->port]);
+}
 
+// Función para leer un registro de un dispositivo I2C
+esp_err_t i2c_master_read_slave_reg(as7265x_head_t *head, uint8_t reg_addr, uint8_t *data) {
+    int64_t start = esp_timer_get_time();
+    esp_err_t ret = bus_acquire(head);
+    if (ret == ESP_OK) {
+        ret = hal_i2c_read_reg(head->port, AS7263_ADDR, reg_addr, data);
+        bus_release(head);
+    }
+    if (ret != ESP_OK) {
+        metrics_count(METRIC_I2C_ERRORS, 1);
+    }
+    metrics_observe_since(METRIC_HIST_I2C_AS7265X, start);
     return ret;
 }
 
 // Función para escribir en un registro de un dispositivo I2C
-esp_err_t i2c_master_write_slave_reg(uint8_t reg_addr, uint8_t data) {
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (AS7263_ADDR << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd, reg_addr, true);
-    i2c_master_write_byte(cmd, data, true);
-    i2c_master_stop(cmd);
-    esp_err_t ret = i2c_master_cmd_begin(I2C_MASTER_NUM, cmd, pdMS_TO_TICKS(1000));
-    i2c_cmd_link_delete(cmd);
+esp_err_t i2c_master_write_slave_reg(as7265x_head_t *head, uint8_t reg_addr, uint8_t data) {
+    int64_t start = esp_timer_get_time();
+    esp_err_t ret = bus_acquire(head);
+    if (ret == ESP_OK) {
+        ret = hal_i2c_write(head->port, AS7263_ADDR, reg_addr, &data, 1);
+        bus_release(head);
+    }
+    if (ret != ESP_OK) {
+        metrics_count(METRIC_I2C_ERRORS, 1);
+    }
+    metrics_observe_since(METRIC_HIST_I2C_AS7265X, start);
     return ret;
 }
 
-// Escritura en un registro virtual
-void write_virtual_register(uint8_t reg, uint8_t value) {
+// Protocolo de registros virtuales acotado: cada operación tiene un plazo de
+// AS7265X_VREG_TIMEOUT_MS para sus esperas de STATUS y se reintenta entera
+// AS7265X_VREG_RETRIES veces; si aun así falla, el error sube hasta
+// sensor_task, que descarta la trama y recupera el bus.
+#define VREG_TIMEOUT_US (CONFIG_AS7265X_VREG_TIMEOUT_MS * 1000LL)
+// Sondeos seguidos (cediendo solo a tareas de igual prioridad) antes de
+// dormir un tick entre sondeos: normalmente STATUS ya está listo en el primero
+#define VREG_FAST_POLLS 3
+
+// Espera a que los bits mask de STATUS estén a set antes de deadline
+static esp_err_t wait_status(as7265x_head_t *head, uint8_t mask, bool set, int64_t deadline) {
     uint8_t status;
-    do {
-        i2c_master_read_slave_reg(I2C_AS72XX_SLAVE_STATUS_REG, &status);
-    } while (status & 0x02); // Espera hasta que TX_VALID sea 0
 
-    // Escribe la dirección del registro
-    uint8_t reg_with_write = reg | 0x80;
-    i2c_master_write_slave_reg(I2C_AS72XX_SLAVE_WRITE_REG, reg_with_write);
+    for (int poll = 0;; poll++) {
+        esp_err_t ret = i2c_master_read_slave_reg(head, I2C_AS72XX_SLAVE_STATUS_REG, &status);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        if (((status & mask) != 0) == set) {
+            return ESP_OK;
+        }
+        if (esp_timer_get_time() >= deadline) {
+            metrics_count(METRIC_VREG_TIMEOUTS, 1);
+            return ESP_ERR_TIMEOUT;
+        }
+        if (poll < VREG_FAST_POLLS) {
+            taskYIELD();
+        } else {
+            vTaskDelay(1);
+        }
+    }
+}
 
-    do {
-        i2c_master_read_slave_reg(I2C_AS72XX_SLAVE_STATUS_REG, &status);
-    } while (status & 0x02); // Espera hasta que TX_VALID sea 0
+static esp_err_t write_virtual_register_once(as7265x_head_t *head, uint8_t reg, uint8_t value) {
+    int64_t deadline = esp_timer_get_time() + VREG_TIMEOUT_US;
 
-    // Escribe el valor
-    i2c_master_write_slave_reg(I2C_AS72XX_SLAVE_WRITE_REG, value);
+    esp_err_t ret = wait_status(head, AS7265X_STATUS_TX_VALID, false, deadline);
+    if (ret == ESP_OK) {
+        // Escribe la dirección del registro
+        ret = i2c_master_write_slave_reg(head, I2C_AS72XX_SLAVE_WRITE_REG, reg | 0x80);
+    }
+    if (ret == ESP_OK) {
+        ret = wait_status(head, AS7265X_STATUS_TX_VALID, false, deadline);
+    }
+    if (ret == ESP_OK) {
+        // Escribe el valor
+        ret = i2c_master_write_slave_reg(head, I2C_AS72XX_SLAVE_WRITE_REG, value);
+    }
+    return ret;
 }
 
-// Lectura de un registro virtual
-uint8_t read_virtual_register(uint8_t reg) {
-    uint8_t status, data;
+static esp_err_t read_virtual_register_once(as7265x_head_t *head, uint8_t reg, uint8_t *value, bool retry) {
+    int64_t deadline = esp_timer_get_time() + VREG_TIMEOUT_US;
+    esp_err_t ret = ESP_OK;
+    uint8_t status;
 
-    do {
-        i2c_master_read_slave_reg(I2C_AS72XX_SLAVE_STATUS_REG, &status);
-    } while (status & 0x02); // Espera hasta que TX_VALID sea 0
+    // En un reintento puede quedar el dato de la lectura interrumpida
+    if (retry) {
+        ret = i2c_master_read_slave_reg(head, I2C_AS72XX_SLAVE_STATUS_REG, &status);
+        if (ret == ESP_OK && (status & AS7265X_STATUS_RX_VALID)) {
+            ret = i2c_master_read_slave_reg(head, I2C_AS72XX_SLAVE_READ_REG, value);
+        }
+    }
+    if (ret == ESP_OK) {
+        ret = wait_status(head, AS7265X_STATUS_TX_VALID, false, deadline);
+    }
+    if (ret == ESP_OK) {
+        // Escribe la dirección del registro
+        ret = i2c_master_write_slave_reg(head, I2C_AS72XX_SLAVE_WRITE_REG, reg);
+    }
+    if (ret == ESP_OK) {
+        ret = wait_status(head, AS7265X_STATUS_RX_VALID, true, deadline);
+    }
+    if (ret == ESP_OK) {
+        // Lee el dato
+        ret = i2c_master_read_slave_reg(head, I2C_AS72XX_SLAVE_READ_REG, value);
+    }
+    return ret;
+}
 
-    // Escribe la dirección del registro
-    i2c_master_write_slave_reg(I2C_AS72XX_SLAVE_WRITE_REG, reg);
+// Escritura en un registro virtual
+esp_err_t write_virtual_register(as7265x_head_t *head, uint8_t reg, uint8_t value) {
+    esp_err_t ret = write_virtual_register_once(head, reg, value);
+    for (int attempt = 0; ret != ESP_OK && attempt < CONFIG_AS7265X_VREG_RETRIES; attempt++) {
+        ret = write_virtual_register_once(head, reg, value);
+    }
+    return ret;
+}
 
-    do {
-        i2c_master_read_slave_reg(I2C_AS72XX_SLAVE_STATUS_REG, &status);
-    } while (!(status & 0x01)); // Espera hasta que RX_VALID sea 1
+// Lectura de un registro virtual
+esp_err_t read_virtual_register(as7265x_head_t *head, uint8_t reg, uint8_t *value) {
+    TRACE_BEGIN(TRACE_VREG_READ, reg);
+    esp_err_t ret = read_virtual_register_once(head, reg, value, false);
+    for (int attempt = 0; ret != ESP_OK && attempt < CONFIG_AS7265X_VREG_RETRIES; attempt++) {
+        ret = read_virtual_register_once(head, reg, value, true);
+    }
+    TRACE_END(TRACE_VREG_READ, reg);
+    return ret;
+}
 
-    // Lee el dato
-    i2c_master_read_slave_reg(I2C_AS72XX_SLAVE_READ_REG, &data);
+// Función para leer los valores crudos de los canales
+esp_err_t read_raw_value(as7265x_head_t *head, uint8_t high_reg, uint8_t low_reg, uint16_t *value) {
+    uint8_t high_byte, low_byte;
 
-    return data;
+    esp_err_t ret = read_virtual_register(head, high_reg, &high_byte);  // Leer el byte alto
+    if (ret == ESP_OK) {
+        ret = read_virtual_register(head, low_reg, &low_byte);          // Leer el byte bajo
+    }
+    if (ret == ESP_OK) {
+        *value = (high_byte << 8) | low_byte;                           // Combinar ambos bytes
+    }
+    return ret;
 }
 
-// Función para leer los valores crudos de los canales
-uint16_t read_raw_value(uint8_t high_reg, uint8_t low_reg) {
-    uint8_t high_byte = read_virtual_register(high_reg);  // Leer el byte alto
-    uint8_t low_byte = read_virtual_register(low_reg);    // Leer el byte bajo
-    return (high_byte << 8) | low_byte;                    // Combinar ambos bytes
+// Valor calibrado de fábrica: float IEEE 754 en 4 registros, el más significativo primero
+esp_err_t read_calibrated_value(as7265x_head_t *head, uint8_t first_reg, float *value) {
+    uint32_t bits = 0;
+
+    for (int i = 0; i < 4; i++) {
+        uint8_t byte;
+        esp_err_t ret = read_virtual_register(head, first_reg + i, &byte);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        bits = (bits << 8) | byte;
+    }
+    memcpy(value, &bits, sizeof(*value));
+    return ESP_OK;
 }
 
 // Función para seleccionar el sensor activo
-void select_sensor(sensor_t sensor) {
-    write_virtual_register(DEV_SEL_REG, sensor);
-    vTaskDelay(pdMS_TO_TICKS(10));  // Pequeña espera para que el cambio tenga efecto
+esp_err_t select_sensor(as7265x_head_t *head, sensor_t sensor) {
+    TRACE_BEGIN(TRACE_DEV_SELECT, sensor);
+    esp_err_t ret = write_virtual_register(head, DEV_SEL_REG, sensor);
+    if (ret == ESP_OK) {
+        vTaskDelay(pdMS_TO_TICKS(10));  // Pequeña espera para que el cambio tenga efecto
+    }
+    TRACE_END(TRACE_DEV_SELECT, sensor);
+    return ret;
 }
 
-// Función para leer los valores crudos de los canales para un sensor específico
-void read_sensor_values(sensor_t sensor,uint16_t *values) {
-    select_sensor(sensor);
+// Función para leer la temperatura del dispositivo seleccionado
+esp_err_t read_temperature(as7265x_head_t *head, int16_t *temperature) {
+    uint8_t value;
+    esp_err_t ret = read_virtual_register(head, VIRTUAL_REG_DEVICE_TEMP, &value);
+    if (ret == ESP_OK) {
+        DLOG(DLOG_LEVEL_DEBUG, DLOG_TEMPERATURE, value);
+        *temperature = value;
+    }
+    return ret;
+}
+
+// Función para leer los valores crudos de los canales para un sensor específico,
+// junto con su temperatura y (si calibrated no es NULL) los valores calibrados
+// en la misma pasada, sin volver a seleccionar el dispositivo. Solo se leen
+// los canales de mask (6 bits); los demás quedan a 0.
+esp_err_t read_sensor_values(as7265x_head_t *head, sensor_t sensor,uint16_t *values, int16_t *temperature, float *calibrated,
+                             uint32_t mask) {
+    esp_err_t ret = select_sensor(head, sensor);
+    if (ret != ESP_OK) {
+        return ret;
+    }
     vTaskDelay(pdMS_TO_TICKS(10)); // Esperar para estabilizar datos
 
-    for (int i = 0; i < 6; i++) {
-        values[i] = read_raw_value(0x08 + (i * 2), 0x09 + (i * 2));
+    for (int i = 0; i < 6 && ret == ESP_OK; i++) {
+        values[i] = 0;
+        if (mask & (1u << i)) {
+            ret = read_raw_value(head, RAW_DATA_REG + (i * 2), RAW_DATA_REG + 1 + (i * 2), &values[i]);
+        }
+    }
+    if (ret == ESP_OK) {
+        ret = read_temperature(head, temperature);
     }
 
-    char labels[3][6] = { "RSTUVW", "GHIJKL", "ABCDEF" };
-    printf("%c: %u, %c: %u, %c: %u, %c: %u, %c: %u, %c: %u\n",
-        labels[sensor][0], values[0],
-        labels[sensor][1], values[1],
-        labels[sensor][2], values[2],
-        labels[sensor][3], values[3],
-        labels[sensor][4], values[4],
-        labels[sensor][5], values[5]);
+    if (calibrated != NULL) {
+        for (int i = 0; i < 6 && ret == ESP_OK; i++) {
+            calibrated[i] = 0.0f;
+            if (mask & (1u << i)) {
+                ret = read_calibrated_value(head, CALIBRATED_DATA_REG + (i * 4), &calibrated[i]);
+            }
+        }
+    }
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    // Sensor 0: RSTUVW, 1: GHIJKL, 2: ABCDEF
+    DLOG(DLOG_LEVEL_DEBUG, DLOG_SENSOR_VALUES, sensor,
+         values[0], values[1], values[2], values[3], values[4], values[5]);
+    return ESP_OK;
 }
 
-// Función para leer la temperatura
-int read_temperature() {
-    uint8_t temperature = read_virtual_register(VIRTUAL_REG_DEVICE_TEMP);
-    printf("Temperatura del sensor: %d °C\n", temperature);
-    return temperature;
+#if CONFIG_ILLUM_INTERLEAVED
+#define ILLUM_INTERLEAVED_DEFAULT true
+#else
+#define ILLUM_INTERLEAVED_DEFAULT false
+#endif
+
+// Iluminación: la pide RPC u otra tarea y sensor_task la aplica entre tramas
+static as7265x_illum_t illum_requested = {
+    .interleaved = ILLUM_INTERLEAVED_DEFAULT,
+    .current = { CONFIG_ILLUM_WHITE_CURRENT, CONFIG_ILLUM_IR_CURRENT, CONFIG_ILLUM_UV_CURRENT },
+};
+static portMUX_TYPE illum_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void as7265x_set_illumination(const as7265x_illum_t *illum) {
+    portENTER_CRITICAL(&illum_lock);
+    illum_requested = *illum;
+    portEXIT_CRITICAL(&illum_lock);
 }
 
+void as7265x_get_illumination(as7265x_illum_t *illum) {
+    portENTER_CRITICAL(&illum_lock);
+    *illum = illum_requested;
+    portEXIT_CRITICAL(&illum_lock);
+}
 
+// Máscara de canales pedida; cada sensor_task la copia a su cabezal entre tramas
+static volatile uint32_t channel_mask_requested = CONFIG_AS7265X_CHANNEL_MASK;
 
+esp_err_t as7265x_set_channel_mask(uint32_t mask) {
+    if ((mask & AS7265X_ALL_CHANNELS) == 0 || (mask & ~AS7265X_ALL_CHANNELS) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    channel_mask_requested = mask;
+    return ESP_OK;
+}
 
-void as7265x_init() {
-    printf("Iniciando sensor AS7265X...\n");
+uint32_t as7265x_get_channel_mask(void) {
+    return channel_mask_requested;
+}
 
-    // Leer el ID del sensor para verificar la comunicación
-    uint8_t device_id = read_virtual_register(0x00);
-    printf("ID del dispositivo AS7265X: 0x%02X\n", device_id);
-    // Leer las versiones del hardware y firmware
-    uint8_t hw_version = read_virtual_register(0x01);
-    uint8_t fw_version = read_virtual_register(0x02);
-    printf("HW Version: 0x%02X\n", hw_version);
-    printf("FW Version: 0x%02X\n", fw_version);
+static bool illum_equal(const as7265x_illum_t *a, const as7265x_illum_t *b) {
+    if (a->interleaved != b->interleaved) {
+        return false;
+    }
+    for (int i = 0; i < AS7265X_NUM_DEVICES; i++) {
+        if (a->current[i] != b->current[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Enciende o apaga el driver de LED de cada dispositivo con su corriente
+static esp_err_t set_leds(as7265x_head_t *head, const as7265x_illum_t *illum, bool on) {
+    esp_err_t ret = ESP_OK;
+
+    for (int i = 0; i < AS7265X_NUM_DEVICES && ret == ESP_OK; i++) {
+        uint8_t led_config = 0;
+        if (on && illum->current[i] != AS7265X_LED_OFF) {
+            led_config = LED_DRV_ENABLE | ((illum->current[i] - 1) << LED_DRV_CURRENT_SHIFT);
+        }
+        ret = select_sensor(head, (sensor_t)i);
+        if (ret == ESP_OK) {
+            ret = write_virtual_register(head, LED_CONFIG_REG, led_config);
+        }
+    }
+    return ret;
+}
+
+// Espera a que termine la integración en curso y se complete otra entera con
+// el nuevo estado de los LEDs (el sensor integra de forma continua)
+static void wait_for_fresh_integration(const as7265x_head_t *head) {
+    vTaskDelay(pdMS_TO_TICKS(2 * head->integration_reg * 28 / 10 + 1));
+}
 
-    // Configurar el sensor para medir en modo continuo
+// Lee los dispositivos de la máscara y rellena la trama, sin contarla en las
+// métricas: quien la pide decide qué es una trama adquirida
+static esp_err_t read_frame_devices(as7265x_head_t *head, sample_frame_t *frame, float calibrated[SAMPLE_CHANNELS]) {
+    int64_t frame_start = esp_timer_get_time();
+    uint32_t mask = head->channel_mask;
+    int temperature_sum = 0;
+    int devices_read = 0;
+
+    for (int i=0; i<3;i++){
+        uint32_t device_mask = (mask >> (i * 6)) & 0x3F;
+        if (device_mask == 0) {
+            // Ningún canal de este dispositivo: ni DEV_SEL ni lecturas
+            memset(&frame->values[i*6], 0, 6 * sizeof(frame->values[0]));
+            if (calibrated != NULL) {
+                memset(&calibrated[i*6], 0, 6 * sizeof(calibrated[0]));
+            }
+            continue;
+        }
+        esp_err_t ret = read_sensor_values(head, (sensor_t)i,&frame->values[i*6],&frame->die_temperature[i],
+                                           calibrated ? &calibrated[i*6] : NULL, device_mask);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        temperature_sum += frame->die_temperature[i];
+        devices_read++;
+    }
+    frame->temperature = (temperature_sum + devices_read / 2) / devices_read;
+    // Los dispositivos no leídos toman la media de los leídos
+    for (int i = 0; i < 3; i++) {
+        if (((mask >> (i * 6)) & 0x3F) == 0) {
+            frame->die_temperature[i] = frame->temperature;
+        }
+    }
+    frame->acquired_us = frame_start;
+    frame->head = head->id;
+    frame->channel_mask = mask;
+    frame->trigger_id = 0;
+    frame->burst_id = 0;
+    frame->label = -1;
+    frame->confidence = 0;
+    frame->novel = 0;
+    frame->distance = 0;
+
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    frame->timestamp_ms = (int64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000;
+    return ESP_OK;
+}
 
-    write_virtual_register(0x04, 0x28);  //gain x16 modo: 2 6 canales 
-    write_virtual_register(0x05, 0x3B);  //Tint: 165ms
+// Trama con los LEDs encendidos menos trama con los LEDs apagados: queda
+// solo la luz reflejada de la iluminación, sin la ambiente. Las dos lecturas
+// cuentan como una sola trama adquirida.
+static esp_err_t read_frame_interleaved(as7265x_head_t *head, const as7265x_illum_t *illum, sample_frame_t *frame,
+                                        float calibrated[SAMPLE_CHANNELS]) {
+    int64_t frame_start = esp_timer_get_time();
+    sample_frame_t lit;
+    float lit_calibrated[SAMPLE_CHANNELS];
+
+    esp_err_t ret = set_leds(head, illum, true);
+    if (ret == ESP_OK) {
+        wait_for_fresh_integration(head);
+        ret = read_frame_devices(head, &lit, calibrated ? lit_calibrated : NULL);
+    }
+    if (ret == ESP_OK) {
+        ret = set_leds(head, illum, false);
+    }
+    if (ret == ESP_OK) {
+        wait_for_fresh_integration(head);
+        ret = read_frame_devices(head, frame, calibrated);
+    }
+    metrics_observe_since(METRIC_HIST_FRAME_ACQ, frame_start);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    metrics_count(METRIC_FRAMES_ACQUIRED, 1);
+    TRACE_INSTANT(TRACE_FRAME_COMPLETE, head->id);
+
+    for (int i = 0; i < SAMPLE_CHANNELS; i++) {
+        frame->values[i] = lit.values[i] > frame->values[i] ? lit.values[i] - frame->values[i] : 0;
+        if (calibrated != NULL) {
+            calibrated[i] = lit_calibrated[i] - calibrated[i];
+        }
+    }
+    return ESP_OK;
+}
+
+// Identificación de cada cabezal guardada en NVS: en los arranques siguientes
+// se aplica la configuración sin volver a leer el ID (la ganancia y Tint
+// vienen de acq_settings)
+typedef struct {
+    uint8_t device_id;
+    uint8_t hw_version;
+    uint8_t fw_version;
+} head_cache_t;
+
+#define NVS_NAMESPACE "as7265x"
+
+static bool load_head_cache(int id, head_cache_t *cache) {
+    nvs_handle_t nvs;
+    char key[8];
+    size_t size = sizeof(*cache);
+    bool ok = false;
+
+    snprintf(key, sizeof(key), "head%d", id);
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs) == ESP_OK) {
+        ok = nvs_get_blob(nvs, key, cache, &size) == ESP_OK && size == sizeof(*cache);
+        nvs_close(nvs);
+    }
+    return ok;
+}
+
+static void store_head_cache(int id, const head_cache_t *cache) {
+    nvs_handle_t nvs;
+    char key[8];
+
+    snprintf(key, sizeof(key), "head%d", id);
+    if (nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs) == ESP_OK) {
+        if (nvs_set_blob(nvs, key, cache, sizeof(*cache)) == ESP_OK) {
+            nvs_commit(nvs);
+        }
+        nvs_close(nvs);
+    }
+}
+
+// Configurar el sensor para medir en modo continuo
+static esp_err_t head_configure(as7265x_head_t *head) {
+    esp_err_t ret = write_virtual_register(head, CONFIG_REG, head->config_reg);
+    if (ret == ESP_OK) {
+        ret = write_virtual_register(head, INTEGRATION_REG, head->integration_reg);
+    }
+    return ret;
+}
+
+// Desde la tarea de cada cabezal, de modo que se configuran a la vez entre sí
+// y con la pantalla y la WiFi
+esp_err_t as7265x_head_init(as7265x_head_t *head) {
+    head_cache_t cache;
+    esp_err_t ret = ESP_OK;
+
+    printf("Iniciando sensor AS7265X (cabezal %d)...\n", head->id);
+
+    if (!load_head_cache(head->id, &cache)) {
+        // Leer el ID del sensor para verificar la comunicación
+        ret = read_virtual_register(head, 0x00, &cache.device_id);
+        // Leer las versiones del hardware y firmware
+        if (ret == ESP_OK) {
+            ret = read_virtual_register(head, 0x01, &cache.hw_version);
+        }
+        if (ret == ESP_OK) {
+            ret = read_virtual_register(head, 0x02, &cache.fw_version);
+        }
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Cabezal %d: el sensor no responde (%s)", head->id, esp_err_to_name(ret));
+            return ret;
+        }
+        store_head_cache(head->id, &cache);
+    }
+    printf("ID del dispositivo AS7265X: 0x%02X\n", cache.device_id);
+    printf("HW Version: 0x%02X\n", cache.hw_version);
+    printf("FW Version: 0x%02X\n", cache.fw_version);
+
+    ret = head_configure(head);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Cabezal %d: no se pudo configurar (%s)", head->id, esp_err_to_name(ret));
+        return ret;
+    }
 
     printf("Configuración del sensor completada.\n");
+    boot_phase_done(BOOT_PHASE_SENSOR);
+    return ESP_OK;
+}
+
+// Tras un fallo del protocolo: libera el bus (el sensor o la pantalla pueden
+// haber quedado reteniendo SDA) y vuelve a programar la configuración del
+// cabezal, por si el sensor se reinició
+esp_err_t as7265x_recover(as7265x_head_t *head) {
+    metrics_count(METRIC_BUS_RECOVERIES, 1);
+
+    xSemaphoreTake(port_locks[head->port], portMAX_DELAY);
+    esp_err_t ret = hal_i2c_bus_recover(head->port);
+    port_mux_channel[head->port] = -1;  // El multiplexor pudo perder la selección
+    xSemaphoreGive(port_locks[head->port]);
+
+    if (ret == ESP_OK) {
+        ret = head_configure(head);
+    }
+    ESP_LOGW(TAG, "Cabezal %d: recuperación del bus %s", head->id, ret == ESP_OK ? "correcta" : esp_err_to_name(ret));
+    return ret;
+}
+
+void as7265x_init() {
+    acq_settings_t settings;
+
+    acq_settings_load();
+    acq_settings_get(&settings);
+
+    for (int port = 0; port < HAL_I2C_PORTS; port++) {
+        port_locks[port] = xSemaphoreCreateMutex();
+    }
+
+    for (int i = 0; i < AS7265X_NUM_HEADS; i++) {
+        heads[i] = (as7265x_head_t){
+            .id = i,
+#if CONFIG_AS7265X_HEADS_DUAL_PORT
+            .port = i,
+#endif
+#if CONFIG_AS7265X_HEADS_MUX
+            .mux_channel = i,
+#else
+            .mux_channel = -1,
+#endif
+            .config_reg = CONFIG_MODE_CONTINUOUS | (settings.gain << CONFIG_GAIN_SHIFT),
+            .integration_reg = settings.tint,
+            .channel_mask = CONFIG_AS7265X_CHANNEL_MASK,
+        };
+    }
+}
+
+int as7265x_num_heads(void) {
+    return AS7265X_NUM_HEADS;
+}
+
+as7265x_head_t *as7265x_get_head(int id) {
+    return id >= 0 && id < AS7265X_NUM_HEADS ? &heads[id] : NULL;
 }
 
-#define LED_GPIO GPIO_NUM_2
 void gpio_init() {
-    gpio_reset_pin(LED_GPIO);
-    gpio_set_direction(LED_GPIO, GPIO_MODE_OUTPUT);
+    hal_led_init();
+}
+
+// Lee una trama completa (6 valores y la temperatura de cada uno de los 3 sensores)
+esp_err_t as7265x_read_frame(as7265x_head_t *head, sample_frame_t *frame) {
+    return as7265x_read_frame_calibrated(head, frame, NULL);
 }
+
+// Igual que as7265x_read_frame y, si calibrated no es NULL, también los 18
+// valores calibrados de fábrica (4 lecturas de registro virtual más por canal)
+esp_err_t as7265x_read_frame_calibrated(as7265x_head_t *head, sample_frame_t *frame, float calibrated[SAMPLE_CHANNELS]) {
+    int64_t frame_start = esp_timer_get_time();
+
+    esp_err_t ret = read_frame_devices(head, frame, calibrated);
+    metrics_observe_since(METRIC_HIST_FRAME_ACQ, frame_start);
+    if (ret == ESP_OK) {
+        metrics_count(METRIC_FRAMES_ACQUIRED, 1);
+        TRACE_INSTANT(TRACE_FRAME_COMPLETE, head->id);
+    }
+    return ret;
+}
+
+// n tramas seguidas sin procesarlas. Cada una empieza al menos una integración
+// después de la anterior (antes repetiría los valores), así que la cadencia la
+// marcan la lectura por I2C y Tint, no la publicación.
+esp_err_t as7265x_capture_burst(as7265x_head_t *head, sample_frame_t *frames, int n, int *captured) {
+    const int64_t tick_us = portTICK_PERIOD_MS * 1000LL;
+    int64_t period_us = head->integration_reg * 2800LL;
+    esp_err_t err = ESP_OK;
+
+    *captured = 0;
+    for (int i = 0; i < n; i++) {
+        int64_t frame_start = esp_timer_get_time();
+        err = as7265x_read_frame(head, &frames[i]);
+        if (err != ESP_OK) {
+            break;
+        }
+        (*captured)++;
+
+        int64_t wait_us = frame_start + period_us - esp_timer_get_time();
+        if (i + 1 < n && wait_us > 0) {
+            vTaskDelay((wait_us + tick_us - 1) / tick_us);
+        }
+    }
+    return err;
+}
+
+// Ráfaga pedida por RPC o HTTP: captura a RAM y después, ya fuera del camino
+// de adquisición, deriva, anillo de muestras y una sola publicación
+static void run_burst(as7265x_head_t *head, int n, uint32_t id) {
+    sample_frame_t *frames = burst_buffer();
+    int captured;
+
+    int64_t start = esp_timer_get_time();
+    esp_err_t err = as7265x_capture_burst(head, frames, n, &captured);
+    int64_t duration_us = esp_timer_get_time() - start;
+    burst_captured(captured, duration_us);
+
+    ESP_LOGI(TAG, "Cabezal %d: ráfaga %" PRIu32 " con %d/%d tramas en %" PRId64 " ms (%.1f tramas/s)", head->id, id,
+             captured, n, duration_us / 1000, duration_us > 0 ? captured * 1e6 / duration_us : 0.0);
+    if (err != ESP_OK) {
+        as7265x_recover(head);
+    }
+    if (captured == 0) {
+        return;
+    }
+
+    for (int i = 0; i < captured; i++) {
+        drift_compensate(&frames[i]);
+#if CONFIG_CLASSIFIER_ENABLED
+        classifier_classify(&frames[i]);
+#endif
+        frames[i].burst_id = id;  // La tarea de publicación no las sube una a una
+        sample_ring_push(&frames[i]);
+    }
+    burst_uploaded(send_burst_to_thingsboard_mqtt(frames, captured, id));
+}
+
+// Programa la ganancia y Tint de unos parámetros nuevos; si el sensor no los
+// acepta se deja la configuración anterior y se reintenta en la siguiente trama
+static esp_err_t apply_settings(as7265x_head_t *head, const acq_settings_t *settings) {
+    uint8_t config_reg = head->config_reg, integration_reg = head->integration_reg;
+    esp_err_t err = ESP_OK;
+
+    head->config_reg = CONFIG_MODE_CONTINUOUS | (settings->gain << CONFIG_GAIN_SHIFT);
+    head->integration_reg = settings->tint;
+    if (head->config_reg != config_reg || head->integration_reg != integration_reg) {
+        err = head_configure(head);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Cabezal %d: no se pudieron aplicar ganancia y Tint (%s)", head->id, esp_err_to_name(err));
+        head->config_reg = config_reg;
+        head->integration_reg = integration_reg;
+        as7265x_recover(head);
+        return err;
+    }
+    ESP_LOGI(TAG, "Cabezal %d: periodo %" PRIu32 " ms, ganancia %u, Tint %u, lote %u, banda muerta %u", head->id,
+             settings->period_ms, settings->gain, settings->tint, settings->batch, settings->deadband);
+    return ESP_OK;
+}
+
+// Tarea de adquisición de un cabezal (pvParameter: as7265x_head_t *)
 void sensor_task(void *pvParameter) {
+    as7265x_head_t *head = pvParameter;
+    bool first_frame = true;
+#if CONFIG_HEAP_GUARD
+    int warmup_frames = CONFIG_HEAP_GUARD_WARMUP_FRAMES;
+#endif
+
+    as7265x_illum_t illum = { .interleaved = false };
+
+    // Sin sensor no hay nada que adquirir: se reintenta recuperando el bus
+    while (as7265x_head_init(head) != ESP_OK) {
+        as7265x_recover(head);
+        vTaskDelay(pdMS_TO_TICKS(1000));
+    }
+    burst_head_running(head->id);
+
+#if CONFIG_TRIGGER_ENABLED
+    int trigger_slot = trigger_add_sampler();
+    trigger_event_t trigger = {0};
+    int burst_remaining = 0;
+#endif
+
+    // Versión 0: en la primera trama se aplican los vigentes aunque cambiaran
+    // mientras el cabezal arrancaba
+    acq_settings_t settings;
+    uint32_t settings_version = 0;
+    acq_settings_get(&settings);
 
     // Leer datos del sensor
     while (1) {
-        // Leer los valores crudos de los canales
-        uint16_t values[18];  // 6 valores por cada uno de los 3 sensores
-
-        for (int i=0; i<3;i++){
-            read_sensor_values((sensor_t)i,&values[i*6]);
-        }
-        // Leer la temperatura
-        int temperature = read_temperature();
-        uint8_t tint = read_virtual_register(0x05);
-        printf("Tint: %d\n", tint);
-        
-        uint8_t gain2 = read_virtual_register(0x04);
-        printf("Gain 2: %d\n", gain2);
-        if (tint == 59 && (gain2 == 40 || gain2 == 42)){
+        sample_frame_t frame;
+        as7265x_illum_t requested;
+        uint32_t burst_id;
+#if CONFIG_AS7265X_CALIBRATED_READOUT
+        float *calibrated = frame.calibrated;
+#else
+        float *calibrated = NULL;
+#endif
+
+        int burst_frames = burst_take(head->id, &burst_id);
+        if (burst_frames > 0) {
+            run_burst(head, burst_frames, burst_id);
+        }
+
+#if CONFIG_TRIGGER_ENABLED
+        // Entre ráfagas la tarea duerme hasta el siguiente flanco (despertando
+        // cada 100 ms para atender las ráfagas a RAM)
+        if (burst_remaining == 0) {
+            if (!trigger_wait(trigger_slot, &trigger, pdMS_TO_TICKS(100))) {
+                continue;
+            }
+            burst_remaining = CONFIG_TRIGGER_BURST_FRAMES;
+        }
+#endif
+
+        // Cambios de iluminación solo en el límite entre tramas
+        as7265x_get_illumination(&requested);
+        if (!illum_equal(&requested, &illum)) {
+            // Si no se pueden apagar los LEDs el cambio se reintenta en la siguiente trama
+            if (!(illum.interleaved && !requested.interleaved) || set_leds(head, &requested, false) == ESP_OK) {
+                illum = requested;
+                ESP_LOGI(TAG, "Cabezal %d: iluminación %s, corrientes %d/%d/%d", head->id,
+                         illum.interleaved ? "intercalada" : "apagada",
+                         illum.current[0], illum.current[1], illum.current[2]);
+            }
+        }
+
+        // Y los de la máscara de canales
+        uint32_t mask = as7265x_get_channel_mask();
+        if (mask != head->channel_mask) {
+            head->channel_mask = mask;
+            ESP_LOGI(TAG, "Cabezal %d: máscara de canales 0x%05" PRIx32, head->id, mask);
+        }
+
+        // Y los parámetros de adquisición; ganancia y Tint se programan en el sensor
+        acq_settings_t new_settings;
+        uint32_t version = acq_settings_get(&new_settings);
+        if (version != settings_version && apply_settings(head, &new_settings) == ESP_OK) {
+            settings = new_settings;
+            settings_version = version;
+            if (acq_settings_applied(version)) {
+                thingsboard_report_settings(&settings);
+            }
+        }
+
+        int64_t acquired_us = esp_timer_get_time();
+        uint8_t tint, gain2;
+        esp_err_t err;
+        if (illum.interleaved) {
+            err = read_frame_interleaved(head, &illum, &frame, calibrated);
+        } else {
+            err = as7265x_read_frame_calibrated(head, &frame, calibrated);
+        }
+        if (err == ESP_OK) {
+            err = read_virtual_register(head, 0x05, &tint);
+        }
+        if (err == ESP_OK) {
+            err = read_virtual_register(head, 0x04, &gain2);
+        }
+        if (err != ESP_OK) {
+            // Trama descartada: se libera el bus y se reconfigura el cabezal
+            ESP_LOGW(TAG, "Cabezal %d: trama descartada (%s)", head->id, esp_err_to_name(err));
+            hud_display_sensor_status(false);
+            as7265x_recover(head);
+            vTaskDelay(pdMS_TO_TICKS(1000));
+            continue;
+        }
+
+        frame.acquired_us = acquired_us;  // Desde el comienzo de la lectura (las dos si es intercalada)
+#if CONFIG_TRIGGER_ENABLED
+        frame.trigger_id = trigger.id;
+        if (burst_remaining == CONFIG_TRIGGER_BURST_FRAMES) {
+            metrics_observe_since(METRIC_HIST_TRIGGER, trigger.edge_us);
+        }
+        if (--burst_remaining == 0) {
+            trigger_burst_done(trigger_slot);
+        }
+#endif
+        DLOG(DLOG_LEVEL_DEBUG, DLOG_SENSOR_CONFIG, tint, gain2);
+        if (tint == head->integration_reg && (gain2 & CONFIG_GAIN_MODE_MASK) == head->config_reg){
             hud_display_sensor_status(true);
         }else hud_display_sensor_status(false);
 
-        send_data_to_thingsboard_mqtt(values, temperature); // Enviar datos a ThingsBoard
+        // Valores corregidos a la temperatura de referencia antes de calibrar y publicar
+        drift_compensate(&frame);
+
+#if CONFIG_CLASSIFIER_ENABLED
+        // Material de la trama y si se parece a los de entrenamiento (la caché
+        // evita la inferencia con el mismo material delante)
+        classifier_classify(&frame);
+#endif
+
+        // Referencias de calibración de esta ganancia/Tint y captura en curso
+        calibration_process_frame(&frame, gain2, tint);
 
-        vTaskDelay(pdMS_TO_TICKS(1000));  // 1 segundo de espera
+        if (first_frame) {
+            boot_phase_done(BOOT_PHASE_FIRST_FRAME);
+            first_frame = false;
+        }
+
+        // Guardar la trama en el anillo de muestras: desde ahí la leen sin
+        // copiarla la publicación en ThingsBoard, el stream WebSocket y el histórico
+        sample_ring_push(&frame);
+
+#if CONFIG_HEAP_GUARD
+        // Pasado el calentamiento el bucle no debe volver a reservar memoria
+        if (warmup_frames > 0 && --warmup_frames == 0) {
+            heap_guard_arm();
+        }
+#endif
+
+#if !CONFIG_TRIGGER_ENABLED
+        // Lo que falte del periodo de muestreo desde el comienzo de la trama
+        int64_t wait_us = acquired_us + settings.period_ms * 1000LL - esp_timer_get_time();
+        if (wait_us > 0) {
+            vTaskDelay((wait_us + portTICK_PERIOD_MS * 1000 - 1) / (portTICK_PERIOD_MS * 1000));
+        }
+#endif
+        // Con disparo externo las tramas de una ráfaga van seguidas
     }
 }
@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_event.h"
+#include "esp_netif.h"
+#include "esp_eth.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_cpu.h"
+#include "thingsboard_control.h"
+#include "metrics.h"
+#include "trace.h"
+#include "dlog.h"
+#include "sample_ring.h"
+#include "spectral.h"
+#include "bench_qemu.h"
+
+static const char *TAG = "bench_qemu";
+
+// Segundos de calentamiento (conexión MQTT, primeras tramas) antes de medir
+#define BENCH_WARMUP_S 5
+
+typedef struct {
+    int64_t time_us;
+    uint32_t acquired;
+    uint32_t published;
+    uint32_t acked;
+    uint32_t publish_errors;
+    uint32_t puback_count;
+    uint64_t puback_sum_us;
+} bench_snapshot_t;
+
+static void take_snapshot(bench_snapshot_t *s) {
+    s->time_us = esp_timer_get_time();
+    s->acquired = metrics_get_counter(METRIC_FRAMES_ACQUIRED);
+    s->published = metrics_get_counter(METRIC_FRAMES_PUBLISHED);
+    s->acked = metrics_get_counter(METRIC_FRAMES_ACKED);
+    s->publish_errors = metrics_get_counter(METRIC_PUBLISH_ERRORS);
+    metrics_get_hist(METRIC_HIST_PUBACK, &s->puback_count, &s->puback_sum_us);
+}
+
+// Ciclos de CPU de la etapa de características sobre la última trama del anillo
+static double feature_cycles_per_frame(void) {
+    const sample_frame_t *frame = sample_ring_acquire(sample_ring_next_seq() - 1);
+    int num_ratios;
+    const spectral_ratio_t *ratios = spectral_telemetry_ratios(&num_ratios);
+    spectral_features_t features;
+
+    if (frame == NULL) {
+        return 0;
+    }
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (int i = 0; i < 100; i++) {
+        spectral_compute(frame->values, ratios, num_ratios, &features);
+    }
+    uint32_t cycles = esp_cpu_get_cycle_count() - start;
+    sample_ring_release(frame);
+    return cycles / 100.0;
+}
+
+// Mide la ventana [calentamiento, calentamiento + duración] y la resume en
+// líneas "BENCH clave=valor" que recoge tools/qemu_bench.sh
+static void bench_task(void *pvParameter) {
+    bench_snapshot_t start, end;
+
+    vTaskDelay(pdMS_TO_TICKS(BENCH_WARMUP_S * 1000));
+    take_snapshot(&start);
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_BENCH_DURATION_S * 1000));
+    take_snapshot(&end);
+
+    double elapsed_s = (end.time_us - start.time_us) / 1e6;
+    uint32_t acquired = end.acquired - start.acquired;
+    uint32_t acked = end.acked - start.acked;
+    uint32_t puback_count = end.puback_count - start.puback_count;
+    double puback_mean_ms = puback_count ? (end.puback_sum_us - start.puback_sum_us) / 1e3 / puback_count : 0;
+
+    // Las tramas perdidas incluyen la que pudiera estar en vuelo al cerrar la ventana
+    printf("BENCH duration_s=%.1f\n", elapsed_s);
+    printf("BENCH frames_acquired=%" PRIu32 "\n", acquired);
+    printf("BENCH frames_published=%" PRIu32 "\n", end.published - start.published);
+    printf("BENCH frames_acked=%" PRIu32 "\n", acked);
+    printf("BENCH frames_dropped=%" PRIu32 "\n", acquired > acked ? acquired - acked : 0);
+    printf("BENCH publish_errors=%" PRIu32 "\n", end.publish_errors - start.publish_errors);
+    printf("BENCH fps=%.3f\n", acked / elapsed_s);
+    printf("BENCH acquisition_to_puback_ms=%.1f\n", puback_mean_ms);
+    printf("BENCH heap_min_free_bytes=%" PRIu32 "\n", esp_get_minimum_free_heap_size());
+    printf("BENCH feature_cycles_per_frame=%.0f\n", feature_cycles_per_frame());
+    trace_dump_uart();
+    dlog_dump_uart();
+    printf("BENCH_DONE\n");
+    fflush(stdout);
+
+    vTaskDelete(NULL);
+}
+
+static void got_ip_handler(void *arg, esp_event_base_t event_base, int32_t event_id, void *event_data) {
+    ip_event_got_ip_t *event = (ip_event_got_ip_t *)event_data;
+
+    ESP_LOGI(TAG, "IP obtenida: " IPSTR, IP2STR(&event->ip_info.ip));
+    mqtt_app_start();
+    xTaskCreate(bench_task, "bench_task", 3072, NULL, 3, NULL);
+}
+
+void bench_qemu_start(void) {
+    ESP_ERROR_CHECK(esp_netif_init());
+    ESP_ERROR_CHECK(esp_event_loop_create_default());
+
+    esp_netif_config_t netif_cfg = ESP_NETIF_DEFAULT_ETH();
+    esp_netif_t *netif = esp_netif_new(&netif_cfg);
+
+    // MAC OpenCores emulada por QEMU (-nic user,model=open_eth)
+    eth_mac_config_t mac_config = ETH_MAC_DEFAULT_CONFIG();
+    eth_phy_config_t phy_config = ETH_PHY_DEFAULT_CONFIG();
+    phy_config.autonego_timeout_ms = 100;
+    esp_eth_mac_t *mac = esp_eth_mac_new_openeth(&mac_config);
+    esp_eth_phy_t *phy = esp_eth_phy_new_dp83848(&phy_config);
+
+    esp_eth_config_t eth_config = ETH_DEFAULT_CONFIG(mac, phy);
+    esp_eth_handle_t eth_handle = NULL;
+    ESP_ERROR_CHECK(esp_eth_driver_install(&eth_config, &eth_handle));
+    ESP_ERROR_CHECK(esp_netif_attach(netif, esp_eth_new_netif_glue(eth_handle)));
+
+    ESP_ERROR_CHECK(esp_event_handler_register(IP_EVENT, IP_EVENT_ETH_GOT_IP, &got_ip_handler, NULL));
+    ESP_ERROR_CHECK(esp_eth_start(eth_handle));
+}
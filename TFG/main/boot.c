@@ -0,0 +1,174 @@
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "nvs.h"
+#include "hal.h"
+#include "boot.h"
+
+static const char *TAG = "boot";
+
+#define NVS_NAMESPACE "boot"
+#define NVS_KEY_DEVMAP "devmap"
+
+// Un NACK vuelve enseguida; el tiempo de espera solo cuenta con el bus colgado
+#define PROBE_TIMEOUT_MS 10
+
+static const char *const phase_names[BOOT_PHASE_COUNT] = {
+    [BOOT_PHASE_NVS] = "nvs",
+    [BOOT_PHASE_I2C] = "i2c",
+    [BOOT_PHASE_SENSOR] = "sensor",
+    [BOOT_PHASE_OLED] = "oled",
+    [BOOT_PHASE_WIFI] = "wifi",
+    [BOOT_PHASE_MQTT] = "mqtt",
+    [BOOT_PHASE_FIRST_FRAME] = "first_frame",
+    [BOOT_PHASE_FIRST_TELEMETRY] = "first_telemetry",
+};
+
+static int64_t phase_us[BOOT_PHASE_COUNT] = { [0 ... BOOT_PHASE_COUNT - 1] = -1 };
+static portMUX_TYPE boot_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Direcciones que respondieron en cada puerto (bit addr de present[port])
+typedef struct {
+    uint8_t present[HAL_I2C_PORTS][16];
+} devmap_t;
+
+static devmap_t devmap;
+
+void boot_phase_done(boot_phase_t phase) {
+    int64_t now = esp_timer_get_time();
+    bool first = false;
+
+    portENTER_CRITICAL(&boot_lock);
+    if (phase_us[phase] < 0) {
+        phase_us[phase] = now;
+        first = true;
+    }
+    portEXIT_CRITICAL(&boot_lock);
+
+    if (first) {
+        ESP_LOGI(TAG, "Fase %s completada a los %" PRId64 " ms", phase_names[phase], now / 1000);
+    }
+    if (first && phase == BOOT_PHASE_FIRST_TELEMETRY) {
+        for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+            if (phase_us[i] >= 0) {
+                ESP_LOGI(TAG, "  %-16s %6" PRId64 " ms", phase_names[i], phase_us[i] / 1000);
+            }
+        }
+    }
+}
+
+int64_t boot_phase_us(boot_phase_t phase) {
+    return phase_us[phase];
+}
+
+const char *boot_phase_name(boot_phase_t phase) {
+    return phase_names[phase];
+}
+
+static bool map_get(const devmap_t *map, uint8_t port, uint8_t addr) {
+    return map->present[port][addr / 8] & (1 << (addr % 8));
+}
+
+static void map_set(devmap_t *map, uint8_t port, uint8_t addr) {
+    map->present[port][addr / 8] |= 1 << (addr % 8);
+}
+
+bool boot_device_present(uint8_t port, uint8_t addr) {
+    return port < HAL_I2C_PORTS && addr < 128 && map_get(&devmap, port, addr);
+}
+
+static bool load_devmap(devmap_t *map) {
+    nvs_handle_t nvs;
+    size_t size = sizeof(*map);
+    bool ok = false;
+
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs) == ESP_OK) {
+        ok = nvs_get_blob(nvs, NVS_KEY_DEVMAP, map, &size) == ESP_OK && size == sizeof(*map);
+        nvs_close(nvs);
+    }
+    return ok;
+}
+
+static void store_devmap(const devmap_t *map) {
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+
+    if (err == ESP_OK) {
+        err = nvs_set_blob(nvs, NVS_KEY_DEVMAP, map, sizeof(*map));
+        if (err == ESP_OK) {
+            err = nvs_commit(nvs);
+        }
+        nvs_close(nvs);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "No se pudo guardar el mapa de dispositivos: %s", esp_err_to_name(err));
+    }
+}
+
+// Sondea solo las direcciones del mapa guardado; false si alguna no responde
+static bool probe_cached(const devmap_t *cached) {
+    for (int port = 0; port < HAL_I2C_PORTS; port++) {
+        for (int addr = 1; addr < 127; addr++) {
+            if (map_get(cached, port, addr) && hal_i2c_probe(port, addr, PROBE_TIMEOUT_MS) != ESP_OK) {
+                ESP_LOGW(TAG, "0x%02X ya no responde en el puerto %d", addr, port);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void scan_port(devmap_t *map, uint8_t port) {
+    ESP_LOGI(TAG, "Escaneando el puerto I2C %d...", port);
+    for (int addr = 1; addr < 127; addr++) {
+        if (hal_i2c_probe(port, addr, PROBE_TIMEOUT_MS) == ESP_OK) {
+            map_set(map, port, addr);
+        }
+    }
+}
+
+void boot_probe_i2c(const boot_i2c_dev_t *expected, int num_expected) {
+    devmap_t cached = {0};
+#if CONFIG_I2C_FULL_SCAN
+    bool fast = false;
+#else
+    bool fast = load_devmap(&cached);
+#endif
+
+    for (int i = 0; fast && i < num_expected; i++) {
+        fast = map_get(&cached, expected[i].port, expected[i].addr);
+    }
+    if (fast && probe_cached(&cached)) {
+        devmap = cached;
+        ESP_LOGI(TAG, "Dispositivos I2C del mapa guardado confirmados");
+    } else {
+        bool port_used[HAL_I2C_PORTS] = { true };  // El puerto 0 siempre (pantalla)
+        memset(&devmap, 0, sizeof(devmap));
+        for (int i = 0; i < num_expected; i++) {
+            port_used[expected[i].port] = true;
+        }
+        for (int port = 0; port < HAL_I2C_PORTS; port++) {
+            if (port_used[port]) {
+                scan_port(&devmap, port);
+            }
+        }
+        if (memcmp(&devmap, &cached, sizeof(devmap)) != 0) {
+            store_devmap(&devmap);
+        }
+    }
+
+    for (int port = 0; port < HAL_I2C_PORTS; port++) {
+        for (int addr = 1; addr < 127; addr++) {
+            if (map_get(&devmap, port, addr)) {
+                ESP_LOGI(TAG, "Dispositivo en el puerto %d, dirección 0x%02X", port, addr);
+            }
+        }
+    }
+    for (int i = 0; i < num_expected; i++) {
+        if (!map_get(&devmap, expected[i].port, expected[i].addr)) {
+            ESP_LOGW(TAG, "No responde 0x%02X en el puerto %d", expected[i].addr, expected[i].port);
+        }
+    }
+}
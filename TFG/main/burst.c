@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "as7265x.h"
+#include "burst.h"
+
+static const char *TAG = "burst";
+
+// Una sola ráfaga a la vez, del cabezal que la pida
+static sample_frame_t frames[CONFIG_BURST_MAX_FRAMES];
+static burst_status_t status = { .state = BURST_IDLE };
+static uint32_t next_id = 1;
+// Cabezales cuya sensor_task ya ha salido del bucle de arranque; a los demás
+// no se les asigna ráfaga porque se quedaría pendiente para siempre
+static bool head_running[AS7265X_NUM_HEADS];
+static portMUX_TYPE burst_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static const char *const state_names[] = {
+    [BURST_IDLE] = "idle",
+    [BURST_PENDING] = "pending",
+    [BURST_CAPTURING] = "capturing",
+    [BURST_UPLOADING] = "uploading",
+    [BURST_DONE] = "done",
+    [BURST_FAILED] = "failed",
+};
+
+esp_err_t burst_request(int head, int n) {
+    esp_err_t err = ESP_OK;
+    bool running;
+
+    if (head < 0 || head >= AS7265X_NUM_HEADS || n <= 0 || n > CONFIG_BURST_MAX_FRAMES) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&burst_lock);
+    running = head_running[head];
+    if (!running || status.state == BURST_PENDING || status.state == BURST_CAPTURING || status.state == BURST_UPLOADING) {
+        err = ESP_ERR_INVALID_STATE;
+    } else {
+        status = (burst_status_t){
+            .state = BURST_PENDING,
+            .id = next_id++,
+            .head = head,
+            .requested = n,
+        };
+    }
+    portEXIT_CRITICAL(&burst_lock);
+
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Cabezal %d: ráfaga de %d tramas pedida", head, n);
+    } else {
+        ESP_LOGW(TAG, "Cabezal %d: ráfaga rechazada (%s)", head,
+                 running ? "hay otra en curso" : "el cabezal no ha arrancado");
+    }
+    return err;
+}
+
+void burst_get_status(burst_status_t *out) {
+    portENTER_CRITICAL(&burst_lock);
+    *out = status;
+    portEXIT_CRITICAL(&burst_lock);
+}
+
+const char *burst_state_name(burst_state_t state) {
+    return state_names[state];
+}
+
+void burst_head_running(int head) {
+    portENTER_CRITICAL(&burst_lock);
+    head_running[head] = true;
+    portEXIT_CRITICAL(&burst_lock);
+}
+
+int burst_take(int head, uint32_t *id) {
+    int n = 0;
+
+    portENTER_CRITICAL(&burst_lock);
+    if (status.state == BURST_PENDING && status.head == head) {
+        status.state = BURST_CAPTURING;
+        n = status.requested;
+        *id = status.id;
+    }
+    portEXIT_CRITICAL(&burst_lock);
+    return n;
+}
+
+sample_frame_t *burst_buffer(void) {
+    return frames;
+}
+
+void burst_captured(int captured, int64_t duration_us) {
+    portENTER_CRITICAL(&burst_lock);
+    status.captured = captured;
+    status.duration_us = duration_us;
+    status.state = captured > 0 ? BURST_UPLOADING : BURST_FAILED;
+    portEXIT_CRITICAL(&burst_lock);
+}
+
+void burst_uploaded(bool ok) {
+    portENTER_CRITICAL(&burst_lock);
+    status.state = ok ? BURST_DONE : BURST_FAILED;
+    portEXIT_CRITICAL(&burst_lock);
+}
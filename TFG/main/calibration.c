@@ -0,0 +1,259 @@
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "nvs.h"
+#include "heap_guard.h"
+#include "calibration.h"
+
+static const char *TAG = "calibration";
+
+#define NVS_NAMESPACE "calib"
+
+static const char ref_prefix[CAL_REF_COUNT] = { 'd', 'w' };
+static const char *const ref_names[CAL_REF_COUNT] = { "oscura", "blanca" };
+
+typedef struct {
+    uint16_t mean[SAMPLE_CHANNELS];
+    bool valid;
+} cal_ref_t;
+
+// Estado de calibración de un cabezal
+typedef struct {
+    // Referencias de la ganancia y Tint actuales
+    cal_ref_t refs[CAL_REF_COUNT];
+    int cur_gain;
+    int cur_tint;
+
+    // Petición de captura (desde RPC o HTTP) que sensor_task recoge en la siguiente trama
+    int pending_kind;
+    int pending_frames;
+
+    // Captura en curso: solo la toca la tarea de adquisición del cabezal
+    int capture_kind;
+    int capture_total;
+    int capture_done;
+    uint32_t capture_sum[SAMPLE_CHANNELS];
+} cal_head_t;
+
+static cal_head_t heads[AS7265X_NUM_HEADS] = {
+    [0 ... AS7265X_NUM_HEADS - 1] = { .cur_gain = -1, .cur_tint = -1, .pending_kind = -1, .capture_kind = -1 },
+};
+
+static portMUX_TYPE cal_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// El cabezal 0 conserva las claves de cuando solo había uno
+static void ref_key(char *key, size_t len, int head, cal_ref_kind_t kind, int gain, int tint) {
+    if (head == 0) {
+        snprintf(key, len, "%c_g%d_t%d", ref_prefix[kind], gain, tint);
+    } else {
+        snprintf(key, len, "%c_h%d_g%d_t%d", ref_prefix[kind], head, gain, tint);
+    }
+}
+
+// Carga de NVS las referencias de una configuración (o las invalida si no hay)
+static void load_refs(int head, int gain, int tint) {
+    cal_ref_t loaded[CAL_REF_COUNT] = {0};
+    nvs_handle_t nvs;
+
+    // Desde sensor_task al cambiar de ganancia o Tint: NVS puede reservar memoria
+    heap_guard_allow_begin();
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs) == ESP_OK) {
+        for (int kind = 0; kind < CAL_REF_COUNT; kind++) {
+            char key[16];
+            size_t size = sizeof(loaded[kind].mean);
+            ref_key(key, sizeof(key), head, kind, gain, tint);
+            loaded[kind].valid = nvs_get_blob(nvs, key, loaded[kind].mean, &size) == ESP_OK &&
+                                 size == sizeof(loaded[kind].mean);
+        }
+        nvs_close(nvs);
+    }
+    heap_guard_allow_end();
+
+    portENTER_CRITICAL(&cal_lock);
+    memcpy(heads[head].refs, loaded, sizeof(heads[head].refs));
+    heads[head].cur_gain = gain;
+    heads[head].cur_tint = tint;
+    portEXIT_CRITICAL(&cal_lock);
+
+    ESP_LOGI(TAG, "Cabezal %d, ganancia %d, Tint %d: referencia oscura %s, blanca %s", head, gain, tint,
+             loaded[CAL_REF_DARK].valid ? "sí" : "no", loaded[CAL_REF_WHITE].valid ? "sí" : "no");
+}
+
+static void store_ref(int head, cal_ref_kind_t kind, const uint16_t mean[SAMPLE_CHANNELS]) {
+    nvs_handle_t nvs;
+    char key[16];
+    esp_err_t err;
+
+    ref_key(key, sizeof(key), head, kind, heads[head].cur_gain, heads[head].cur_tint);
+    // Al acabar una captura, desde sensor_task: NVS puede reservar memoria
+    heap_guard_allow_begin();
+    err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(nvs, key, mean, SAMPLE_CHANNELS * sizeof(uint16_t));
+        if (err == ESP_OK) {
+            err = nvs_commit(nvs);
+        }
+        nvs_close(nvs);
+    }
+    heap_guard_allow_end();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "No se pudo guardar la referencia %s: %s", ref_names[kind], esp_err_to_name(err));
+    }
+}
+
+esp_err_t calibration_request(int head, cal_ref_kind_t kind, int frames) {
+    esp_err_t err = ESP_OK;
+
+    if (head < 0 || head >= AS7265X_NUM_HEADS || kind < 0 || kind >= CAL_REF_COUNT || frames < 0 ||
+        frames > CALIBRATION_MAX_FRAMES) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (frames == 0) {
+        frames = CONFIG_CALIBRATION_FRAMES;
+    }
+
+    cal_head_t *h = &heads[head];
+    portENTER_CRITICAL(&cal_lock);
+    if (h->pending_kind >= 0 || h->capture_kind >= 0) {
+        err = ESP_ERR_INVALID_STATE;
+    } else {
+        h->pending_kind = kind;
+        h->pending_frames = frames;
+    }
+    portEXIT_CRITICAL(&cal_lock);
+
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Cabezal %d: capturando referencia %s con %d tramas", head, ref_names[kind], frames);
+    }
+    return err;
+}
+
+esp_err_t calibration_clear(int head) {
+    nvs_handle_t nvs;
+    int gain, tint;
+
+    if (head < 0 || head >= AS7265X_NUM_HEADS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    cal_head_t *h = &heads[head];
+    portENTER_CRITICAL(&cal_lock);
+    gain = h->cur_gain;
+    tint = h->cur_tint;
+    h->refs[CAL_REF_DARK].valid = false;
+    h->refs[CAL_REF_WHITE].valid = false;
+    portEXIT_CRITICAL(&cal_lock);
+
+    if (gain < 0) {
+        return ESP_OK;  // Todavía no se ha adquirido ninguna trama
+    }
+
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err != ESP_OK) {
+        return err;
+    }
+    for (int kind = 0; kind < CAL_REF_COUNT; kind++) {
+        char key[16];
+        ref_key(key, sizeof(key), head, kind, gain, tint);
+        nvs_erase_key(nvs, key);  // ESP_ERR_NVS_NOT_FOUND si no existía: no es un error
+    }
+    err = nvs_commit(nvs);
+    nvs_close(nvs);
+    return err;
+}
+
+esp_err_t calibration_get_status(int head, calibration_status_t *status) {
+    if (head < 0 || head >= AS7265X_NUM_HEADS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    cal_head_t *h = &heads[head];
+    portENTER_CRITICAL(&cal_lock);
+    status->gain = h->cur_gain < 0 ? 0 : h->cur_gain;
+    status->tint = h->cur_tint < 0 ? 0 : h->cur_tint;
+    for (int kind = 0; kind < CAL_REF_COUNT; kind++) {
+        status->valid[kind] = h->refs[kind].valid;
+    }
+    if (h->capture_kind >= 0) {
+        status->capturing = h->capture_kind;
+        status->remaining = h->capture_total - h->capture_done;
+    } else {
+        status->capturing = h->pending_kind;
+        status->remaining = h->pending_kind >= 0 ? h->pending_frames : 0;
+    }
+    portEXIT_CRITICAL(&cal_lock);
+    return ESP_OK;
+}
+
+void calibration_process_frame(const sample_frame_t *frame, uint8_t config, uint8_t tint) {
+    int head = frame->head;
+    int gain = (config >> 4) & 0x03;
+    cal_head_t *h = &heads[head];
+
+    // Con otra ganancia o Tint valen otras referencias; una captura a medias se reinicia
+    if (gain != h->cur_gain || tint != h->cur_tint) {
+        load_refs(head, gain, tint);
+        h->capture_done = 0;
+        memset(h->capture_sum, 0, sizeof(h->capture_sum));
+    }
+
+    portENTER_CRITICAL(&cal_lock);
+    if (h->pending_kind >= 0) {
+        h->capture_kind = h->pending_kind;
+        h->capture_total = h->pending_frames;
+        h->capture_done = 0;
+        h->pending_kind = -1;
+    }
+    portEXIT_CRITICAL(&cal_lock);
+
+    if (h->capture_kind < 0) {
+        return;
+    }
+
+    if (h->capture_done == 0) {
+        memset(h->capture_sum, 0, sizeof(h->capture_sum));
+    }
+    for (int i = 0; i < SAMPLE_CHANNELS; i++) {
+        h->capture_sum[i] += frame->values[i];
+    }
+    h->capture_done++;
+    if (h->capture_done < h->capture_total) {
+        return;
+    }
+
+    cal_ref_kind_t kind = h->capture_kind;
+    cal_ref_t ref = { .valid = true };
+    for (int i = 0; i < SAMPLE_CHANNELS; i++) {
+        ref.mean[i] = (h->capture_sum[i] + h->capture_total / 2) / h->capture_total;
+    }
+    store_ref(head, kind, ref.mean);
+
+    portENTER_CRITICAL(&cal_lock);
+    h->refs[kind] = ref;
+    h->capture_kind = -1;
+    portEXIT_CRITICAL(&cal_lock);
+
+    ESP_LOGI(TAG, "Cabezal %d: referencia %s guardada (ganancia %d, Tint %d)", head, ref_names[kind], gain, tint);
+}
+
+bool calibration_apply(int head, const uint16_t raw[SAMPLE_CHANNELS], uint16_t reflectance[SAMPLE_CHANNELS]) {
+    cal_ref_t dark, white;
+
+    portENTER_CRITICAL(&cal_lock);
+    dark = heads[head].refs[CAL_REF_DARK];
+    white = heads[head].refs[CAL_REF_WHITE];
+    portEXIT_CRITICAL(&cal_lock);
+
+    if (!dark.valid || !white.valid) {
+        return false;
+    }
+
+    for (int i = 0; i < SAMPLE_CHANNELS; i++) {
+        int32_t span = (int32_t)white.mean[i] - dark.mean[i];
+        int32_t signal = (int32_t)raw[i] - dark.mean[i];
+        int32_t r = (span <= 0 || signal <= 0) ? 0 : signal * REFLECTANCE_SCALE / span;
+        reflectance[i] = r > UINT16_MAX ? UINT16_MAX : r;
+    }
+    return true;
+}
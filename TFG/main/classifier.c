@@ -0,0 +1,177 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "as7265x.h"
+#include "metrics.h"
+#include "classifier.h"
+#include "spectral.h"
+#include "classifier_model.h"
+
+#define CACHE_ENTRIES CONFIG_CLASSIFIER_CACHE_ENTRIES
+#define CACHE_SHIFT   (16 - CONFIG_CLASSIFIER_CACHE_BITS)
+
+// Entrada de la caché: la trama cuantizada completa (el hash solo acelera la
+// búsqueda) y el resultado de la inferencia
+typedef struct {
+    uint32_t hash;
+    uint32_t last_used;  // Reloj de la caché en el último acierto; 0 = libre
+    uint16_t key[SAMPLE_CHANNELS];
+    int8_t label;
+    uint8_t confidence;
+    uint8_t novel;
+    uint16_t distance;
+} cache_entry_t;
+
+#if CACHE_ENTRIES > 0
+// Una caché por cabezal: solo la toca su sensor_task, sin cerrojos
+static cache_entry_t cache[AS7265X_NUM_HEADS][CACHE_ENTRIES];
+static uint32_t cache_clock[AS7265X_NUM_HEADS];
+#endif
+
+void classifier_run(const sample_frame_t *frame, int8_t *label, uint8_t *confidence) {
+    uint32_t votes[MODEL_NUM_CLASSES] = {0};
+    int best = 0;
+#if MODEL_USES_FEATURES
+    // Entradas 0-17: canales crudos; desde 18, el vector de spectral_get
+    int32_t inputs[SAMPLE_CHANNELS + SPECTRAL_LEN];
+    spectral_features_t features;
+
+    spectral_compute(frame->values, model_feature_ratios, MODEL_NUM_RATIOS, &features);
+    for (int i = 0; i < SAMPLE_CHANNELS; i++) {
+        inputs[i] = frame->values[i];
+    }
+    for (int i = 0; i < SPECTRAL_LEN; i++) {
+        inputs[SAMPLE_CHANNELS + i] = spectral_get(&features, i);
+    }
+#else
+    const uint16_t *inputs = frame->values;
+#endif
+
+    for (int t = 0; t < MODEL_NUM_TREES; t++) {
+        const model_node_t *node = &model_nodes[model_tree_roots[t]];
+        while (node->channel >= 0) {
+            node = &model_nodes[inputs[node->channel] <= node->threshold ? node->left : node->right];
+        }
+        for (int c = 0; c < MODEL_NUM_CLASSES; c++) {
+            votes[c] += model_leaf_proba[node->left][c];
+        }
+    }
+    // Como predict_proba: media de las probabilidades de cada árbol
+    for (int c = 1; c < MODEL_NUM_CLASSES; c++) {
+        if (votes[c] > votes[best]) {
+            best = c;
+        }
+    }
+    *label = best;
+    *confidence = votes[best] / MODEL_NUM_TREES;
+}
+
+uint16_t classifier_novelty(const sample_frame_t *frame, int label, bool *novel) {
+    *novel = false;
+#if MODEL_HAS_NOVELTY
+    const int32_t *mean = model_novelty_mean[label];
+    int32_t diff[SAMPLE_CHANNELS];
+    uint64_t d2 = 0;  // Distancia al cuadrado en Q16
+
+    for (int i = 0; i < SAMPLE_CHANNELS; i++) {
+        diff[i] = frame->values[i] - mean[i];
+    }
+    // d² = |W (x - media)|²: W es triangular superior (Cholesky de la
+    // precisión), así que cada fila empieza en la diagonal
+    for (int r = 0; r < SAMPLE_CHANNELS; r++) {
+        const int32_t *row = model_novelty_whiten[label][r];
+        int64_t acc = 0;  // Q16
+        for (int c = r; c < SAMPLE_CHANNELS; c++) {
+            acc += (int64_t)row[c] * diff[c];
+        }
+        int64_t y = acc >> 8;  // Q8
+        d2 += (uint64_t)(y * y);
+    }
+    *novel = d2 > model_novelty_threshold[label];
+
+    // Distancia x16: sqrt(Q16) da Q8
+    uint32_t distance = spectral_isqrt(d2) >> 4;
+    return distance > UINT16_MAX ? UINT16_MAX : (distance == 0 ? 1 : distance);
+#else
+    (void)frame;
+    (void)label;
+    return 0;
+#endif
+}
+
+#if CACHE_ENTRIES > 0
+// FNV-1a de la trama cuantizada
+static uint32_t quantize(const sample_frame_t *frame, uint16_t key[SAMPLE_CHANNELS]) {
+    uint32_t hash = 2166136261u;
+
+    for (int i = 0; i < SAMPLE_CHANNELS; i++) {
+        key[i] = frame->values[i] >> CACHE_SHIFT;
+        hash = (hash ^ (key[i] & 0xFF)) * 16777619u;
+        hash = (hash ^ (key[i] >> 8)) * 16777619u;
+    }
+    return hash;
+}
+#endif
+
+void classifier_classify(sample_frame_t *frame) {
+    int64_t start = esp_timer_get_time();
+
+#if CACHE_ENTRIES > 0
+    cache_entry_t *entries = cache[frame->head];
+    uint32_t now = ++cache_clock[frame->head];
+    uint16_t key[SAMPLE_CHANNELS];
+    uint32_t hash = quantize(frame, key);
+    cache_entry_t *victim = &entries[0];
+
+    for (int i = 0; i < CACHE_ENTRIES; i++) {
+        cache_entry_t *entry = &entries[i];
+        if (entry->last_used != 0 && entry->hash == hash && memcmp(entry->key, key, sizeof(key)) == 0) {
+            entry->last_used = now;
+            frame->label = entry->label;
+            frame->confidence = entry->confidence;
+            frame->novel = entry->novel;
+            frame->distance = entry->distance;
+            metrics_count(METRIC_CLASSIFIER_CACHE_HITS, 1);
+            if (frame->novel) {
+                metrics_count(METRIC_NOVEL_FRAMES, 1);
+            }
+            metrics_observe_since(METRIC_HIST_CLASSIFY, start);
+            return;
+        }
+        // La libre o, si no hay, la usada hace más tiempo
+        if (entry->last_used < victim->last_used) {
+            victim = entry;
+        }
+    }
+    metrics_count(METRIC_CLASSIFIER_CACHE_MISSES, 1);
+#endif
+
+    classifier_run(frame, &frame->label, &frame->confidence);
+#if CONFIG_CLASSIFIER_NOVELTY
+    bool novel;
+    frame->distance = classifier_novelty(frame, frame->label, &novel);
+    frame->novel = novel;
+    if (novel) {
+        metrics_count(METRIC_NOVEL_FRAMES, 1);
+    }
+#endif
+
+#if CACHE_ENTRIES > 0
+    victim->hash = hash;
+    victim->last_used = now;
+    memcpy(victim->key, key, sizeof(key));
+    victim->label = frame->label;
+    victim->confidence = frame->confidence;
+    victim->novel = frame->novel;
+    victim->distance = frame->distance;
+#endif
+    metrics_observe_since(METRIC_HIST_CLASSIFY, start);
+}
+
+int classifier_num_labels(void) {
+    return MODEL_NUM_CLASSES;
+}
+
+const char *classifier_label_name(int label) {
+    return label >= 0 && label < MODEL_NUM_CLASSES ? model_classes[label] : "?";
+}
@@ -0,0 +1,1925 @@
+// Generado por Machine Learning/exportar_modelo.py a partir de "Modelo de papeles.pkl".
+// No editar a mano: volver a exportar desde app.py (Exportar modelo al firmware).
+#ifndef CLASSIFIER_MODEL_H
+#define CLASSIFIER_MODEL_H
+
+#include <stdint.h>
+
+#define MODEL_NUM_CLASSES 6
+#define MODEL_NUM_TREES 100
+#define MODEL_NUM_NODES 1130
+#define MODEL_USES_FEATURES 0
+#define MODEL_NUM_RATIOS 0
+#define MODEL_HAS_NOVELTY 1
+
+static const char *const model_classes[MODEL_NUM_CLASSES] = {
+    "papel amarillo",
+    "papel azul",
+    "papel azul2",
+    "papel naranja",
+    "papel naranja 2",
+    "papel verde",
+};
+
+static const uint16_t model_tree_roots[MODEL_NUM_TREES] = {
+    0, 11, 22, 35, 46, 57, 68, 79, 90, 101, 112, 123, 134, 145, 156, 167,
+    178, 189, 200, 211, 222, 233, 244, 255, 266, 277, 288, 303, 314, 325, 336, 347,
+    358, 373, 384, 395, 406, 417, 428, 441, 454, 465, 476, 487, 498, 509, 520, 531,
+    542, 553, 564, 575, 586, 597, 608, 619, 634, 645, 656, 667, 678, 689, 700, 711,
+    722, 733, 744, 755, 766, 777, 788, 799, 810, 821, 832, 843, 854, 865, 876, 887,
+    898, 909, 920, 931, 942, 955, 966, 977, 988, 999, 1014, 1025, 1036, 1047, 1058, 1069,
+    1080, 1093, 1106, 1117,
+};
+
+// { canal, umbral (cuentas), izquierda (valor <= umbral) o fila de la hoja, derecha }
+static const model_node_t model_nodes[MODEL_NUM_NODES] = {
+    { 8, 326, 1, 8 },
+    { 7, 378, 2, 7 },
+    { 15, 213, 3, 6 },
+    { 12, 8, 4, 5 },
+    { -1, 0, 0, 0 },
+    { -1, 0, 1, 0 },
+    { -1, 0, 2, 0 },
+    { -1, 0, 3, 0 },
+    { 8, 344, 9, 10 },
+    { -1, 0, 4, 0 },
+    { -1, 0, 5, 0 },
+    { 16, 126, 12, 15 },
+    { 1, 160, 13, 14 },
+    { -1, 0, 6, 0 },
+    { -1, 0, 7, 0 },
+    { 1, 118, 16, 21 },
+    { 12, 12, 17, 20 },
+    { 11, 3, 18, 19 },
+    { -1, 0, 8, 0 },
+    { -1, 0, 9, 0 },
+    { -1, 0, 10, 0 },
+    { -1, 0, 11, 0 },
+    { 17, 139, 23, 28 },
+    { 16, 58, 24, 25 },
+    { -1, 0, 12, 0 },
+    { 1, 160, 26, 27 },
+    { -1, 0, 13, 0 },
+    { -1, 0, 14, 0 },
+    { 13, 59, 29, 30 },
+    { -1, 0, 15, 0 },
+    { 16, 366, 31, 34 },
+    { 16, 267, 32, 33 },
+    { -1, 0, 16, 0 },
+    { -1, 0, 17, 0 },
+    { -1, 0, 18, 0 },
+    { 14, 119, 36, 39 },
+    { 8, 326, 37, 38 },
+    { -1, 0, 19, 0 },
+    { -1, 0, 20, 0 },
+    { 7, 258, 40, 43 },
+    { 14, 475, 41, 42 },
+    { -1, 0, 21, 0 },
+    { -1, 0, 22, 0 },
+    { 5, 19, 44, 45 },
+    { -1, 0, 23, 0 },
+    { -1, 0, 24, 0 },
+    { 14, 119, 47, 50 },
+    { 1, 160, 48, 49 },
+    { -1, 0, 25, 0 },
+    { -1, 0, 26, 0 },
+    { 16, 369, 51, 56 },
+    { 2, 37, 52, 55 },
+    { 9, 19, 53, 54 },
+    { -1, 0, 27, 0 },
+    { -1, 0, 28, 0 },
+    { -1, 0, 29, 0 },
+    { -1, 0, 30, 0 },
+    { 17, 139, 58, 61 },
+    { 0, 544, 59, 60 },
+    { -1, 0, 31, 0 },
+    { -1, 0, 32, 0 },
+    { 5, 19, 62, 67 },
+    { 1, 55, 63, 66 },
+    { 12, 7, 64, 65 },
+    { -1, 0, 33, 0 },
+    { -1, 0, 34, 0 },
+    { -1, 0, 35, 0 },
+    { -1, 0, 36, 0 },
+    { 12, 12, 69, 76 },
+    { 1, 160, 70, 75 },
+    { 15, 213, 71, 74 },
+    { 10, 5, 72, 73 },
+    { -1, 0, 37, 0 },
+    { -1, 0, 38, 0 },
+    { -1, 0, 39, 0 },
+    { -1, 0, 40, 0 },
+    { 11, 8, 77, 78 },
+    { -1, 0, 41, 0 },
+    { -1, 0, 42, 0 },
+    { 1, 160, 80, 89 },
+    { 3, 35, 81, 88 },
+    { 15, 254, 82, 87 },
+    { 15, 213, 83, 86 },
+    { 12, 8, 84, 85 },
+    { -1, 0, 43, 0 },
+    { -1, 0, 44, 0 },
+    { -1, 0, 45, 0 },
+    { -1, 0, 46, 0 },
+    { -1, 0, 47, 0 },
+    { -1, 0, 48, 0 },
+    { 14, 119, 91, 94 },
+    { 0, 544, 92, 93 },
+    { -1, 0, 49, 0 },
+    { -1, 0, 50, 0 },
+    { 15, 155, 95, 96 },
+    { -1, 0, 51, 0 },
+    { 13, 110, 97, 100 },
+    { 1, 53, 98, 99 },
+    { -1, 0, 52, 0 },
+    { -1, 0, 53, 0 },
+    { -1, 0, 54, 0 },
+    { 14, 119, 102, 105 },
+    { 7, 349, 103, 104 },
+    { -1, 0, 55, 0 },
+    { -1, 0, 56, 0 },
+    { 13, 110, 106, 111 },
+    { 16, 368, 107, 110 },
+    { 11, 5, 108, 109 },
+    { -1, 0, 57, 0 },
+    { -1, 0, 58, 0 },
+    { -1, 0, 59, 0 },
+    { -1, 0, 60, 0 },
+    { 17, 156, 113, 116 },
+    { 1, 160, 114, 115 },
+    { -1, 0, 61, 0 },
+    { -1, 0, 62, 0 },
+    { 17, 518, 117, 122 },
+    { 9, 57, 118, 121 },
+    { 11, 3, 119, 120 },
+    { -1, 0, 63, 0 },
+    { -1, 0, 64, 0 },
+    { -1, 0, 65, 0 },
+    { -1, 0, 66, 0 },
+    { 13, 38, 124, 127 },
+    { 8, 326, 125, 126 },
+    { -1, 0, 67, 0 },
+    { -1, 0, 68, 0 },
+    { 17, 518, 128, 133 },
+    { 9, 58, 129, 132 },
+    { 2, 15, 130, 131 },
+    { -1, 0, 69, 0 },
+    { -1, 0, 70, 0 },
+    { -1, 0, 71, 0 },
+    { -1, 0, 72, 0 },
+    { 15, 82, 135, 138 },
+    { 6, 145, 136, 137 },
+    { -1, 0, 73, 0 },
+    { -1, 0, 74, 0 },
+    { 16, 368, 139, 144 },
+    { 14, 475, 140, 143 },
+    { 6, 278, 141, 142 },
+    { -1, 0, 75, 0 },
+    { -1, 0, 76, 0 },
+    { -1, 0, 77, 0 },
+    { -1, 0, 78, 0 },
+    { 17, 156, 146, 149 },
+    { 8, 326, 147, 148 },
+    { -1, 0, 79, 0 },
+    { -1, 0, 80, 0 },
+    { 17, 519, 150, 155 },
+    { 1, 85, 151, 154 },
+    { 3, 11, 152, 153 },
+    { -1, 0, 81, 0 },
+    { -1, 0, 82, 0 },
+    { -1, 0, 83, 0 },
+    { -1, 0, 84, 0 },
+    { 13, 38, 157, 160 },
+    { 0, 544, 158, 159 },
+    { -1, 0, 85, 0 },
+    { -1, 0, 86, 0 },
+    { 0, 515, 161, 166 },
+    { 14, 492, 162, 165 },
+    { 4, 29, 163, 164 },
+    { -1, 0, 87, 0 },
+    { -1, 0, 88, 0 },
+    { -1, 0, 89, 0 },
+    { -1, 0, 90, 0 },
+    { 17, 139, 168, 171 },
+    { 6, 145, 169, 170 },
+    { -1, 0, 91, 0 },
+    { -1, 0, 92, 0 },
+    { 15, 253, 172, 177 },
+    { 17, 395, 173, 176 },
+    { 8, 47, 174, 175 },
+    { -1, 0, 93, 0 },
+    { -1, 0, 94, 0 },
+    { -1, 0, 95, 0 },
+    { -1, 0, 96, 0 },
+    { 17, 518, 179, 188 },
+    { 1, 160, 180, 187 },
+    { 3, 35, 181, 186 },
+    { 11, 3, 182, 183 },
+    { -1, 0, 97, 0 },
+    { 8, 187, 184, 185 },
+    { -1, 0, 98, 0 },
+    { -1, 0, 99, 0 },
+    { -1, 0, 100, 0 },
+    { -1, 0, 101, 0 },
+    { -1, 0, 102, 0 },
+    { 14, 119, 190, 193 },
+    { 6, 145, 191, 192 },
+    { -1, 0, 103, 0 },
+    { -1, 0, 104, 0 },
+    { 13, 110, 194, 199 },
+    { 4, 59, 195, 198 },
+    { 7, 247, 196, 197 },
+    { -1, 0, 105, 0 },
+    { -1, 0, 106, 0 },
+    { -1, 0, 107, 0 },
+    { -1, 0, 108, 0 },
+    { 1, 160, 201, 210 },
+    { 8, 342, 202, 209 },
+    { 13, 110, 203, 208 },
+    { 6, 271, 204, 207 },
+    { 8, 182, 205, 206 },
+    { -1, 0, 109, 0 },
+    { -1, 0, 110, 0 },
+    { -1, 0, 111, 0 },
+    { -1, 0, 112, 0 },
+    { -1, 0, 113, 0 },
+    { -1, 0, 114, 0 },
+    { 15, 82, 212, 215 },
+    { 1, 160, 213, 214 },
+    { -1, 0, 115, 0 },
+    { -1, 0, 116, 0 },
+    { 13, 67, 216, 217 },
+    { -1, 0, 117, 0 },
+    { 16, 366, 218, 221 },
+    { 6, 126, 219, 220 },
+    { -1, 0, 118, 0 },
+    { -1, 0, 119, 0 },
+    { -1, 0, 120, 0 },
+    { 12, 12, 223, 230 },
+    { 8, 326, 224, 229 },
+    { 12, 7, 225, 226 },
+    { -1, 0, 121, 0 },
+    { 8, 187, 227, 228 },
+    { -1, 0, 122, 0 },
+    { -1, 0, 123, 0 },
+    { -1, 0, 124, 0 },
+    { 2, 51, 231, 232 },
+    { -1, 0, 125, 0 },
+    { -1, 0, 126, 0 },
+    { 15, 82, 234, 237 },
+    { 7, 349, 235, 236 },
+    { -1, 0, 127, 0 },
+    { -1, 0, 128, 0 },
+    { 7, 485, 238, 243 },
+    { 6, 269, 239, 242 },
+    { 1, 21, 240, 241 },
+    { -1, 0, 129, 0 },
+    { -1, 0, 130, 0 },
+    { -1, 0, 131, 0 },
+    { -1, 0, 132, 0 },
+    { 1, 160, 245, 254 },
+    { 7, 228, 246, 249 },
+    { 6, 126, 247, 248 },
+    { -1, 0, 133, 0 },
+    { -1, 0, 134, 0 },
+    { 0, 579, 250, 253 },
+    { 10, 8, 251, 252 },
+    { -1, 0, 135, 0 },
+    { -1, 0, 136, 0 },
+    { -1, 0, 137, 0 },
+    { -1, 0, 138, 0 },
+    { 1, 160, 256, 265 },
+    { 2, 54, 257, 264 },
+    { 17, 417, 258, 263 },
+    { 17, 259, 259, 262 },
+    { 6, 128, 260, 261 },
+    { -1, 0, 139, 0 },
+    { -1, 0, 140, 0 },
+    { -1, 0, 141, 0 },
+    { -1, 0, 142, 0 },
+    { -1, 0, 143, 0 },
+    { -1, 0, 144, 0 },
+    { 13, 38, 267, 270 },
+    { 1, 160, 268, 269 },
+    { -1, 0, 145, 0 },
+    { -1, 0, 146, 0 },
+    { 9, 81, 271, 276 },
+    { 12, 12, 272, 275 },
+    { 13, 104, 273, 274 },
+    { -1, 0, 147, 0 },
+    { -1, 0, 148, 0 },
+    { -1, 0, 149, 0 },
+    { -1, 0, 150, 0 },
+    { 16, 144, 278, 281 },
+    { 8, 326, 279, 280 },
+    { -1, 0, 151, 0 },
+    { -1, 0, 152, 0 },
+    { 13, 67, 282, 283 },
+    { -1, 0, 153, 0 },
+    { 8, 136, 284, 287 },
+    { 9, 19, 285, 286 },
+    { -1, 0, 154, 0 },
+    { -1, 0, 155, 0 },
+    { -1, 0, 156, 0 },
+    { 15, 82, 289, 296 },
+    { 3, 33, 290, 293 },
+    { 9, 90, 291, 292 },
+    { -1, 0, 157, 0 },
+    { -1, 0, 158, 0 },
+    { 1, 161, 294, 295 },
+    { -1, 0, 159, 0 },
+    { -1, 0, 160, 0 },
+    { 4, 59, 297, 302 },
+    { 15, 254, 298, 301 },
+    { 16, 266, 299, 300 },
+    { -1, 0, 161, 0 },
+    { -1, 0, 162, 0 },
+    { -1, 0, 163, 0 },
+    { -1, 0, 164, 0 },
+    { 16, 144, 304, 307 },
+    { 0, 544, 305, 306 },
+    { -1, 0, 165, 0 },
+    { -1, 0, 166, 0 },
+    { 17, 518, 308, 313 },
+    { 5, 13, 309, 312 },
+    { 12, 7, 310, 311 },
+    { -1, 0, 167, 0 },
+    { -1, 0, 168, 0 },
+    { -1, 0, 169, 0 },
+    { -1, 0, 170, 0 },
+    { 8, 326, 315, 322 },
+    { 16, 366, 316, 321 },
+    { 15, 213, 317, 320 },
+    { 0, 308, 318, 319 },
+    { -1, 0, 171, 0 },
+    { -1, 0, 172, 0 },
+    { -1, 0, 173, 0 },
+    { -1, 0, 174, 0 },
+    { 1, 155, 323, 324 },
+    { -1, 0, 175, 0 },
+    { -1, 0, 176, 0 },
+    { 14, 119, 326, 329 },
+    { 8, 326, 327, 328 },
+    { -1, 0, 177, 0 },
+    { -1, 0, 178, 0 },
+    { 11, 8, 330, 335 },
+    { 3, 21, 331, 334 },
+    { 15, 213, 332, 333 },
+    { -1, 0, 179, 0 },
+    { -1, 0, 180, 0 },
+    { -1, 0, 181, 0 },
+    { -1, 0, 182, 0 },
+    { 17, 139, 337, 340 },
+    { 1, 160, 338, 339 },
+    { -1, 0, 183, 0 },
+    { -1, 0, 184, 0 },
+    { 4, 59, 341, 346 },
+    { 16, 366, 342, 345 },
+    { 14, 475, 343, 344 },
+    { -1, 0, 185, 0 },
+    { -1, 0, 186, 0 },
+    { -1, 0, 187, 0 },
+    { -1, 0, 188, 0 },
+    { 1, 160, 348, 357 },
+    { 14, 492, 349, 356 },
+    { 5, 22, 350, 355 },
+    { 7, 378, 351, 354 },
+    { 1, 89, 352, 353 },
+    { -1, 0, 189, 0 },
+    { -1, 0, 190, 0 },
+    { -1, 0, 191, 0 },
+    { -1, 0, 192, 0 },
+    { -1, 0, 193, 0 },
+    { -1, 0, 194, 0 },
+    { 15, 82, 359, 366 },
+    { 16, 58, 360, 361 },
+    { -1, 0, 195, 0 },
+    { 14, 91, 362, 365 },
+    { 5, 20, 363, 364 },
+    { -1, 0, 196, 0 },
+    { -1, 0, 197, 0 },
+    { -1, 0, 198, 0 },
+    { 10, 7, 367, 370 },
+    { 14, 475, 368, 369 },
+    { -1, 0, 199, 0 },
+    { -1, 0, 200, 0 },
+    { 17, 518, 371, 372 },
+    { -1, 0, 201, 0 },
+    { -1, 0, 202, 0 },
+    { 15, 82, 374, 377 },
+    { 8, 326, 375, 376 },
+    { -1, 0, 203, 0 },
+    { -1, 0, 204, 0 },
+    { 14, 492, 378, 383 },
+    { 6, 424, 379, 382 },
+    { 1, 53, 380, 381 },
+    { -1, 0, 205, 0 },
+    { -1, 0, 206, 0 },
+    { -1, 0, 207, 0 },
+    { -1, 0, 208, 0 },
+    { 1, 160, 385, 394 },
+    { 8, 342, 386, 393 },
+    { 6, 271, 387, 392 },
+    { 17, 259, 388, 391 },
+    { 6, 129, 389, 390 },
+    { -1, 0, 209, 0 },
+    { -1, 0, 210, 0 },
+    { -1, 0, 211, 0 },
+    { -1, 0, 212, 0 },
+    { -1, 0, 213, 0 },
+    { -1, 0, 214, 0 },
+    { 8, 326, 396, 403 },
+    { 14, 492, 397, 402 },
+    { 7, 378, 398, 401 },
+    { 3, 21, 399, 400 },
+    { -1, 0, 215, 0 },
+    { -1, 0, 216, 0 },
+    { -1, 0, 217, 0 },
+    { -1, 0, 218, 0 },
+    { 17, 291, 404, 405 },
+    { -1, 0, 219, 0 },
+    { -1, 0, 220, 0 },
+    { 1, 160, 407, 416 },
+    { 10, 10, 408, 415 },
+    { 17, 417, 409, 414 },
+    { 16, 267, 410, 413 },
+    { 9, 53, 411, 412 },
+    { -1, 0, 221, 0 },
+    { -1, 0, 222, 0 },
+    { -1, 0, 223, 0 },
+    { -1, 0, 224, 0 },
+    { -1, 0, 225, 0 },
+    { -1, 0, 226, 0 },
+    { 1, 160, 418, 427 },
+    { 11, 8, 419, 426 },
+    { 11, 7, 420, 425 },
+    { 17, 259, 421, 424 },
+    { 6, 128, 422, 423 },
+    { -1, 0, 227, 0 },
+    { -1, 0, 228, 0 },
+    { -1, 0, 229, 0 },
+    { -1, 0, 230, 0 },
+    { -1, 0, 231, 0 },
+    { -1, 0, 232, 0 },
+    { 16, 126, 429, 434 },
+    { 2, 51, 430, 431 },
+    { -1, 0, 233, 0 },
+    { 1, 160, 432, 433 },
+    { -1, 0, 234, 0 },
+    { -1, 0, 235, 0 },
+    { 14, 492, 435, 440 },
+    { 17, 518, 436, 439 },
+    { 16, 268, 437, 438 },
+    { -1, 0, 236, 0 },
+    { -1, 0, 237, 0 },
+    { -1, 0, 238, 0 },
+    { -1, 0, 239, 0 },
+    { 17, 156, 442, 447 },
+    { 2, 51, 443, 444 },
+    { -1, 0, 240, 0 },
+    { 7, 349, 445, 446 },
+    { -1, 0, 241, 0 },
+    { -1, 0, 242, 0 },
+    { 17, 518, 448, 453 },
+    { 13, 104, 449, 452 },
+    { 2, 34, 450, 451 },
+    { -1, 0, 243, 0 },
+    { -1, 0, 244, 0 },
+    { -1, 0, 245, 0 },
+    { -1, 0, 246, 0 },
+    { 1, 160, 455, 464 },
+    { 13, 110, 456, 463 },
+    { 16, 369, 457, 462 },
+    { 9, 92, 458, 461 },
+    { 17, 139, 459, 460 },
+    { -1, 0, 247, 0 },
+    { -1, 0, 248, 0 },
+    { -1, 0, 249, 0 },
+    { -1, 0, 250, 0 },
+    { -1, 0, 251, 0 },
+    { -1, 0, 252, 0 },
+    { 1, 160, 466, 475 },
+    { 16, 369, 467, 474 },
+    { 15, 213, 468, 473 },
+    { 12, 12, 469, 472 },
+    { 6, 129, 470, 471 },
+    { -1, 0, 253, 0 },
+    { -1, 0, 254, 0 },
+    { -1, 0, 255, 0 },
+    { -1, 0, 256, 0 },
+    { -1, 0, 257, 0 },
+    { -1, 0, 258, 0 },
+    { 17, 139, 477, 480 },
+    { 7, 349, 478, 479 },
+    { -1, 0, 259, 0 },
+    { -1, 0, 260, 0 },
+    { 10, 10, 481, 486 },
+    { 6, 269, 482, 485 },
+    { 6, 126, 483, 484 },
+    { -1, 0, 261, 0 },
+    { -1, 0, 262, 0 },
+    { -1, 0, 263, 0 },
+    { -1, 0, 264, 0 },
+    { 15, 82, 488, 491 },
+    { 0, 544, 489, 490 },
+    { -1, 0, 265, 0 },
+    { -1, 0, 266, 0 },
+    { 9, 81, 492, 497 },
+    { 10, 7, 493, 496 },
+    { 12, 7, 494, 495 },
+    { -1, 0, 267, 0 },
+    { -1, 0, 268, 0 },
+    { -1, 0, 269, 0 },
+    { -1, 0, 270, 0 },
+    { 14, 119, 499, 502 },
+    { 0, 544, 500, 501 },
+    { -1, 0, 271, 0 },
+    { -1, 0, 272, 0 },
+    { 13, 59, 503, 504 },
+    { -1, 0, 273, 0 },
+    { 13, 110, 505, 508 },
+    { 14, 428, 506, 507 },
+    { -1, 0, 274, 0 },
+    { -1, 0, 275, 0 },
+    { -1, 0, 276, 0 },
+    { 7, 380, 510, 517 },
+    { 0, 544, 511, 516 },
+    { 1, 21, 512, 513 },
+    { -1, 0, 277, 0 },
+    { 7, 228, 514, 515 },
+    { -1, 0, 278, 0 },
+    { -1, 0, 279, 0 },
+    { -1, 0, 280, 0 },
+    { 3, 34, 518, 519 },
+    { -1, 0, 281, 0 },
+    { -1, 0, 282, 0 },
+    { 16, 142, 521, 524 },
+    { 6, 145, 522, 523 },
+    { -1, 0, 283, 0 },
+    { -1, 0, 284, 0 },
+    { 15, 254, 525, 530 },
+    { 15, 213, 526, 529 },
+    { 12, 10, 527, 528 },
+    { -1, 0, 285, 0 },
+    { -1, 0, 286, 0 },
+    { -1, 0, 287, 0 },
+    { -1, 0, 288, 0 },
+    { 16, 126, 532, 535 },
+    { 0, 544, 533, 534 },
+    { -1, 0, 289, 0 },
+    { -1, 0, 290, 0 },
+    { 13, 110, 536, 541 },
+    { 0, 515, 537, 540 },
+    { 0, 240, 538, 539 },
+    { -1, 0, 291, 0 },
+    { -1, 0, 292, 0 },
+    { -1, 0, 293, 0 },
+    { -1, 0, 294, 0 },
+    { 15, 82, 543, 546 },
+    { 0, 544, 544, 545 },
+    { -1, 0, 295, 0 },
+    { -1, 0, 296, 0 },
+    { 2, 51, 547, 552 },
+    { 11, 6, 548, 551 },
+    { 13, 104, 549, 550 },
+    { -1, 0, 297, 0 },
+    { -1, 0, 298, 0 },
+    { -1, 0, 299, 0 },
+    { -1, 0, 300, 0 },
+    { 14, 119, 554, 557 },
+    { 1, 160, 555, 556 },
+    { -1, 0, 301, 0 },
+    { -1, 0, 302, 0 },
+    { 9, 81, 558, 563 },
+    { 13, 110, 559, 562 },
+    { 4, 29, 560, 561 },
+    { -1, 0, 303, 0 },
+    { -1, 0, 304, 0 },
+    { -1, 0, 305, 0 },
+    { -1, 0, 306, 0 },
+    { 14, 119, 565, 568 },
+    { 7, 349, 566, 567 },
+    { -1, 0, 307, 0 },
+    { -1, 0, 308, 0 },
+    { 4, 59, 569, 574 },
+    { 0, 250, 570, 573 },
+    { 9, 19, 571, 572 },
+    { -1, 0, 309, 0 },
+    { -1, 0, 310, 0 },
+    { -1, 0, 311, 0 },
+    { -1, 0, 312, 0 },
+    { 16, 126, 576, 579 },
+    { 6, 145, 577, 578 },
+    { -1, 0, 313, 0 },
+    { -1, 0, 314, 0 },
+    { 15, 143, 580, 581 },
+    { -1, 0, 315, 0 },
+    { 14, 492, 582, 585 },
+    { 1, 53, 583, 584 },
+    { -1, 0, 316, 0 },
+    { -1, 0, 317, 0 },
+    { -1, 0, 318, 0 },
+    { 17, 139, 587, 590 },
+    { 0, 544, 588, 589 },
+    { -1, 0, 319, 0 },
+    { -1, 0, 320, 0 },
+    { 0, 515, 591, 596 },
+    { 3, 21, 592, 595 },
+    { 15, 213, 593, 594 },
+    { -1, 0, 321, 0 },
+    { -1, 0, 322, 0 },
+    { -1, 0, 323, 0 },
+    { -1, 0, 324, 0 },
+    { 1, 160, 598, 607 },
+    { 0, 579, 599, 606 },
+    { 15, 253, 600, 605 },
+    { 8, 47, 601, 602 },
+    { -1, 0, 325, 0 },
+    { 3, 22, 603, 604 },
+    { -1, 0, 326, 0 },
+    { -1, 0, 327, 0 },
+    { -1, 0, 328, 0 },
+    { -1, 0, 329, 0 },
+    { -1, 0, 330, 0 },
+    { 15, 82, 609, 612 },
+    { 8, 326, 610, 611 },
+    { -1, 0, 331, 0 },
+    { -1, 0, 332, 0 },
+    { 15, 253, 613, 618 },
+    { 15, 213, 614, 617 },
+    { 10, 7, 615, 616 },
+    { -1, 0, 333, 0 },
+    { -1, 0, 334, 0 },
+    { -1, 0, 335, 0 },
+    { -1, 0, 336, 0 },
+    { 13, 38, 620, 627 },
+    { 2, 51, 621, 622 },
+    { -1, 0, 337, 0 },
+    { 4, 56, 623, 626 },
+    { 8, 326, 624, 625 },
+    { -1, 0, 338, 0 },
+    { -1, 0, 339, 0 },
+    { -1, 0, 340, 0 },
+    { 10, 10, 628, 633 },
+    { 3, 21, 629, 632 },
+    { 1, 21, 630, 631 },
+    { -1, 0, 341, 0 },
+    { -1, 0, 342, 0 },
+    { -1, 0, 343, 0 },
+    { -1, 0, 344, 0 },
+    { 0, 544, 635, 642 },
+    { 17, 417, 636, 641 },
+    { 16, 267, 637, 640 },
+    { 3, 21, 638, 639 },
+    { -1, 0, 345, 0 },
+    { -1, 0, 346, 0 },
+    { -1, 0, 347, 0 },
+    { -1, 0, 348, 0 },
+    { 3, 35, 643, 644 },
+    { -1, 0, 349, 0 },
+    { -1, 0, 350, 0 },
+    { 1, 160, 646, 655 },
+    { 7, 485, 647, 654 },
+    { 10, 8, 648, 653 },
+    { 13, 104, 649, 652 },
+    { 9, 53, 650, 651 },
+    { -1, 0, 351, 0 },
+    { -1, 0, 352, 0 },
+    { -1, 0, 353, 0 },
+    { -1, 0, 354, 0 },
+    { -1, 0, 355, 0 },
+    { -1, 0, 356, 0 },
+    { 17, 139, 657, 660 },
+    { 0, 544, 658, 659 },
+    { -1, 0, 357, 0 },
+    { -1, 0, 358, 0 },
+    { 14, 492, 661, 666 },
+    { 1, 118, 662, 665 },
+    { 16, 328, 663, 664 },
+    { -1, 0, 359, 0 },
+    { -1, 0, 360, 0 },
+    { -1, 0, 361, 0 },
+    { -1, 0, 362, 0 },
+    { 17, 139, 668, 671 },
+    { 6, 145, 669, 670 },
+    { -1, 0, 363, 0 },
+    { -1, 0, 364, 0 },
+    { 14, 492, 672, 677 },
+    { 15, 225, 673, 676 },
+    { 17, 359, 674, 675 },
+    { -1, 0, 365, 0 },
+    { -1, 0, 366, 0 },
+    { -1, 0, 367, 0 },
+    { -1, 0, 368, 0 },
+    { 4, 62, 679, 688 },
+    { 0, 544, 680, 687 },
+    { 14, 492, 681, 686 },
+    { 17, 381, 682, 685 },
+    { 5, 12, 683, 684 },
+    { -1, 0, 369, 0 },
+    { -1, 0, 370, 0 },
+    { -1, 0, 371, 0 },
+    { -1, 0, 372, 0 },
+    { -1, 0, 373, 0 },
+    { -1, 0, 374, 0 },
+    { 1, 160, 690, 699 },
+    { 16, 368, 691, 698 },
+    { 15, 213, 692, 697 },
+    { 9, 92, 693, 696 },
+    { 17, 139, 694, 695 },
+    { -1, 0, 375, 0 },
+    { -1, 0, 376, 0 },
+    { -1, 0, 377, 0 },
+    { -1, 0, 378, 0 },
+    { -1, 0, 379, 0 },
+    { -1, 0, 380, 0 },
+    { 17, 155, 701, 704 },
+    { 1, 160, 702, 703 },
+    { -1, 0, 381, 0 },
+    { -1, 0, 382, 0 },
+    { 14, 492, 705, 710 },
+    { 13, 66, 706, 707 },
+    { -1, 0, 383, 0 },
+    { 11, 5, 708, 709 },
+    { -1, 0, 384, 0 },
+    { -1, 0, 385, 0 },
+    { -1, 0, 386, 0 },
+    { 14, 119, 712, 715 },
+    { 1, 160, 713, 714 },
+    { -1, 0, 387, 0 },
+    { -1, 0, 388, 0 },
+    { 9, 82, 716, 721 },
+    { 15, 254, 717, 720 },
+    { 16, 267, 718, 719 },
+    { -1, 0, 389, 0 },
+    { -1, 0, 390, 0 },
+    { -1, 0, 391, 0 },
+    { -1, 0, 392, 0 },
+    { 1, 160, 723, 732 },
+    { 2, 54, 724, 731 },
+    { 17, 418, 725, 730 },
+    { 14, 475, 726, 729 },
+    { 16, 126, 727, 728 },
+    { -1, 0, 393, 0 },
+    { -1, 0, 394, 0 },
+    { -1, 0, 395, 0 },
+    { -1, 0, 396, 0 },
+    { -1, 0, 397, 0 },
+    { -1, 0, 398, 0 },
+    { 17, 156, 734, 737 },
+    { 6, 145, 735, 736 },
+    { -1, 0, 399, 0 },
+    { -1, 0, 400, 0 },
+    { 13, 110, 738, 743 },
+    { 14, 280, 739, 740 },
+    { -1, 0, 401, 0 },
+    { 15, 225, 741, 742 },
+    { -1, 0, 402, 0 },
+    { -1, 0, 403, 0 },
+    { -1, 0, 404, 0 },
+    { 17, 139, 745, 748 },
+    { 0, 544, 746, 747 },
+    { -1, 0, 405, 0 },
+    { -1, 0, 406, 0 },
+    { 3, 34, 749, 754 },
+    { 5, 10, 750, 753 },
+    { 7, 96, 751, 752 },
+    { -1, 0, 407, 0 },
+    { -1, 0, 408, 0 },
+    { -1, 0, 409, 0 },
+    { -1, 0, 410, 0 },
+    { 15, 82, 756, 759 },
+    { 8, 326, 757, 758 },
+    { -1, 0, 411, 0 },
+    { -1, 0, 412, 0 },
+    { 10, 10, 760, 765 },
+    { 16, 366, 761, 764 },
+    { 6, 126, 762, 763 },
+    { -1, 0, 413, 0 },
+    { -1, 0, 414, 0 },
+    { -1, 0, 415, 0 },
+    { -1, 0, 416, 0 },
+    { 13, 38, 767, 770 },
+    { 6, 145, 768, 769 },
+    { -1, 0, 417, 0 },
+    { -1, 0, 418, 0 },
+    { 13, 110, 771, 776 },
+    { 16, 369, 772, 775 },
+    { 6, 278, 773, 774 },
+    { -1, 0, 419, 0 },
+    { -1, 0, 420, 0 },
+    { -1, 0, 421, 0 },
+    { -1, 0, 422, 0 },
+    { 1, 160, 778, 787 },
+    { 7, 485, 779, 786 },
+    { 11, 7, 780, 785 },
+    { 16, 267, 781, 784 },
+    { 8, 182, 782, 783 },
+    { -1, 0, 423, 0 },
+    { -1, 0, 424, 0 },
+    { -1, 0, 425, 0 },
+    { -1, 0, 426, 0 },
+    { -1, 0, 427, 0 },
+    { -1, 0, 428, 0 },
+    { 15, 82, 789, 792 },
+    { 1, 160, 790, 791 },
+    { -1, 0, 429, 0 },
+    { -1, 0, 430, 0 },
+    { 0, 515, 793, 798 },
+    { 4, 30, 794, 797 },
+    { 4, 12, 795, 796 },
+    { -1, 0, 431, 0 },
+    { -1, 0, 432, 0 },
+    { -1, 0, 433, 0 },
+    { -1, 0, 434, 0 },
+    { 1, 160, 800, 809 },
+    { 5, 22, 801, 808 },
+    { 11, 7, 802, 807 },
+    { 14, 475, 803, 806 },
+    { 17, 139, 804, 805 },
+    { -1, 0, 435, 0 },
+    { -1, 0, 436, 0 },
+    { -1, 0, 437, 0 },
+    { -1, 0, 438, 0 },
+    { -1, 0, 439, 0 },
+    { -1, 0, 440, 0 },
+    { 0, 544, 811, 818 },
+    { 13, 110, 812, 817 },
+    { 6, 271, 813, 816 },
+    { 14, 222, 814, 815 },
+    { -1, 0, 441, 0 },
+    { -1, 0, 442, 0 },
+    { -1, 0, 443, 0 },
+    { -1, 0, 444, 0 },
+    { 6, 294, 819, 820 },
+    { -1, 0, 445, 0 },
+    { -1, 0, 446, 0 },
+    { 13, 38, 822, 825 },
+    { 6, 145, 823, 824 },
+    { -1, 0, 447, 0 },
+    { -1, 0, 448, 0 },
+    { 17, 519, 826, 831 },
+    { 15, 213, 827, 830 },
+    { 17, 360, 828, 829 },
+    { -1, 0, 449, 0 },
+    { -1, 0, 450, 0 },
+    { -1, 0, 451, 0 },
+    { -1, 0, 452, 0 },
+    { 4, 53, 833, 838 },
+    { 0, 250, 834, 837 },
+    { 14, 474, 835, 836 },
+    { -1, 0, 453, 0 },
+    { -1, 0, 454, 0 },
+    { -1, 0, 455, 0 },
+    { 4, 62, 839, 842 },
+    { 0, 544, 840, 841 },
+    { -1, 0, 456, 0 },
+    { -1, 0, 457, 0 },
+    { -1, 0, 458, 0 },
+    { 0, 544, 844, 851 },
+    { 11, 7, 845, 850 },
+    { 15, 213, 846, 849 },
+    { 16, 142, 847, 848 },
+    { -1, 0, 459, 0 },
+    { -1, 0, 460, 0 },
+    { -1, 0, 461, 0 },
+    { -1, 0, 462, 0 },
+    { 7, 452, 852, 853 },
+    { -1, 0, 463, 0 },
+    { -1, 0, 464, 0 },
+    { 17, 139, 855, 858 },
+    { 8, 326, 856, 857 },
+    { -1, 0, 465, 0 },
+    { -1, 0, 466, 0 },
+    { 15, 254, 859, 864 },
+    { 10, 8, 860, 863 },
+    { 10, 4, 861, 862 },
+    { -1, 0, 467, 0 },
+    { -1, 0, 468, 0 },
+    { -1, 0, 469, 0 },
+    { -1, 0, 470, 0 },
+    { 15, 82, 866, 869 },
+    { 1, 160, 867, 868 },
+    { -1, 0, 471, 0 },
+    { -1, 0, 472, 0 },
+    { 16, 368, 870, 875 },
+    { 17, 395, 871, 874 },
+    { 9, 19, 872, 873 },
+    { -1, 0, 473, 0 },
+    { -1, 0, 474, 0 },
+    { -1, 0, 475, 0 },
+    { -1, 0, 476, 0 },
+    { 1, 160, 877, 886 },
+    { 0, 579, 878, 885 },
+    { 15, 254, 879, 884 },
+    { 14, 474, 880, 883 },
+    { 14, 250, 881, 882 },
+    { -1, 0, 477, 0 },
+    { -1, 0, 478, 0 },
+    { -1, 0, 479, 0 },
+    { -1, 0, 480, 0 },
+    { -1, 0, 481, 0 },
+    { -1, 0, 482, 0 },
+    { 14, 119, 888, 891 },
+    { 6, 145, 889, 890 },
+    { -1, 0, 483, 0 },
+    { -1, 0, 484, 0 },
+    { 13, 110, 892, 897 },
+    { 15, 226, 893, 896 },
+    { 12, 10, 894, 895 },
+    { -1, 0, 485, 0 },
+    { -1, 0, 486, 0 },
+    { -1, 0, 487, 0 },
+    { -1, 0, 488, 0 },
+    { 13, 38, 899, 902 },
+    { 8, 325, 900, 901 },
+    { -1, 0, 489, 0 },
+    { -1, 0, 490, 0 },
+    { 13, 110, 903, 908 },
+    { 13, 93, 904, 907 },
+    { 8, 201, 905, 906 },
+    { -1, 0, 491, 0 },
+    { -1, 0, 492, 0 },
+    { -1, 0, 493, 0 },
+    { -1, 0, 494, 0 },
+    { 15, 82, 910, 913 },
+    { 0, 544, 911, 912 },
+    { -1, 0, 495, 0 },
+    { -1, 0, 496, 0 },
+    { 15, 254, 914, 919 },
+    { 3, 24, 915, 918 },
+    { 15, 213, 916, 917 },
+    { -1, 0, 497, 0 },
+    { -1, 0, 498, 0 },
+    { -1, 0, 499, 0 },
+    { -1, 0, 500, 0 },
+    { 8, 326, 921, 928 },
+    { 16, 366, 922, 927 },
+    { 16, 266, 923, 926 },
+    { 9, 53, 924, 925 },
+    { -1, 0, 501, 0 },
+    { -1, 0, 502, 0 },
+    { -1, 0, 503, 0 },
+    { -1, 0, 504, 0 },
+    { 17, 291, 929, 930 },
+    { -1, 0, 505, 0 },
+    { -1, 0, 506, 0 },
+    { 14, 119, 932, 935 },
+    { 1, 160, 933, 934 },
+    { -1, 0, 507, 0 },
+    { -1, 0, 508, 0 },
+    { 13, 110, 936, 941 },
+    { 1, 118, 937, 940 },
+    { 11, 5, 938, 939 },
+    { -1, 0, 509, 0 },
+    { -1, 0, 510, 0 },
+    { -1, 0, 511, 0 },
+    { -1, 0, 512, 0 },
+    { 16, 126, 943, 948 },
+    { 17, 88, 944, 945 },
+    { -1, 0, 513, 0 },
+    { 8, 326, 946, 947 },
+    { -1, 0, 514, 0 },
+    { -1, 0, 515, 0 },
+    { 15, 143, 949, 950 },
+    { -1, 0, 516, 0 },
+    { 11, 6, 951, 954 },
+    { 12, 7, 952, 953 },
+    { -1, 0, 517, 0 },
+    { -1, 0, 518, 0 },
+    { -1, 0, 519, 0 },
+    { 3, 35, 956, 965 },
+    { 1, 160, 957, 964 },
+    { 17, 417, 958, 963 },
+    { 16, 266, 959, 962 },
+    { 13, 52, 960, 961 },
+    { -1, 0, 520, 0 },
+    { -1, 0, 521, 0 },
+    { -1, 0, 522, 0 },
+    { -1, 0, 523, 0 },
+    { -1, 0, 524, 0 },
+    { -1, 0, 525, 0 },
+    { 16, 126, 967, 970 },
+    { 7, 349, 968, 969 },
+    { -1, 0, 526, 0 },
+    { -1, 0, 527, 0 },
+    { 6, 425, 971, 976 },
+    { 10, 7, 972, 975 },
+    { 4, 12, 973, 974 },
+    { -1, 0, 528, 0 },
+    { -1, 0, 529, 0 },
+    { -1, 0, 530, 0 },
+    { -1, 0, 531, 0 },
+    { 1, 160, 978, 987 },
+    { 6, 425, 979, 986 },
+    { 16, 366, 980, 985 },
+    { 14, 474, 981, 984 },
+    { 6, 128, 982, 983 },
+    { -1, 0, 532, 0 },
+    { -1, 0, 533, 0 },
+    { -1, 0, 534, 0 },
+    { -1, 0, 535, 0 },
+    { -1, 0, 536, 0 },
+    { -1, 0, 537, 0 },
+    { 15, 82, 989, 992 },
+    { 6, 145, 990, 991 },
+    { -1, 0, 538, 0 },
+    { -1, 0, 539, 0 },
+    { 17, 518, 993, 998 },
+    { 1, 85, 994, 997 },
+    { 7, 96, 995, 996 },
+    { -1, 0, 540, 0 },
+    { -1, 0, 541, 0 },
+    { -1, 0, 542, 0 },
+    { -1, 0, 543, 0 },
+    { 14, 119, 1000, 1007 },
+    { 16, 58, 1001, 1002 },
+    { -1, 0, 544, 0 },
+    { 15, 39, 1003, 1006 },
+    { 5, 20, 1004, 1005 },
+    { -1, 0, 545, 0 },
+    { -1, 0, 546, 0 },
+    { -1, 0, 547, 0 },
+    { 7, 485, 1008, 1013 },
+    { 3, 21, 1009, 1012 },
+    { 16, 267, 1010, 1011 },
+    { -1, 0, 548, 0 },
+    { -1, 0, 549, 0 },
+    { -1, 0, 550, 0 },
+    { -1, 0, 551, 0 },
+    { 14, 119, 1015, 1018 },
+    { 8, 326, 1016, 1017 },
+    { -1, 0, 552, 0 },
+    { -1, 0, 553, 0 },
+    { 4, 59, 1019, 1024 },
+    { 1, 55, 1020, 1023 },
+    { 17, 259, 1021, 1022 },
+    { -1, 0, 554, 0 },
+    { -1, 0, 555, 0 },
+    { -1, 0, 556, 0 },
+    { -1, 0, 557, 0 },
+    { 17, 139, 1026, 1029 },
+    { 0, 544, 1027, 1028 },
+    { -1, 0, 558, 0 },
+    { -1, 0, 559, 0 },
+    { 8, 293, 1030, 1035 },
+    { 16, 366, 1031, 1034 },
+    { 4, 12, 1032, 1033 },
+    { -1, 0, 560, 0 },
+    { -1, 0, 561, 0 },
+    { -1, 0, 562, 0 },
+    { -1, 0, 563, 0 },
+    { 15, 82, 1037, 1040 },
+    { 1, 160, 1038, 1039 },
+    { -1, 0, 564, 0 },
+    { -1, 0, 565, 0 },
+    { 17, 518, 1041, 1046 },
+    { 9, 57, 1042, 1045 },
+    { 13, 104, 1043, 1044 },
+    { -1, 0, 566, 0 },
+    { -1, 0, 567, 0 },
+    { -1, 0, 568, 0 },
+    { -1, 0, 569, 0 },
+    { 13, 38, 1048, 1051 },
+    { 0, 544, 1049, 1050 },
+    { -1, 0, 570, 0 },
+    { -1, 0, 571, 0 },
+    { 4, 59, 1052, 1057 },
+    { 7, 258, 1053, 1056 },
+    { 15, 213, 1054, 1055 },
+    { -1, 0, 572, 0 },
+    { -1, 0, 573, 0 },
+    { -1, 0, 574, 0 },
+    { -1, 0, 575, 0 },
+    { 15, 82, 1059, 1062 },
+    { 7, 350, 1060, 1061 },
+    { -1, 0, 576, 0 },
+    { -1, 0, 577, 0 },
+    { 15, 155, 1063, 1064 },
+    { -1, 0, 578, 0 },
+    { 4, 30, 1065, 1068 },
+    { 16, 267, 1066, 1067 },
+    { -1, 0, 579, 0 },
+    { -1, 0, 580, 0 },
+    { -1, 0, 581, 0 },
+    { 13, 38, 1070, 1073 },
+    { 2, 51, 1071, 1072 },
+    { -1, 0, 582, 0 },
+    { -1, 0, 583, 0 },
+    { 3, 21, 1074, 1077 },
+    { 6, 126, 1075, 1076 },
+    { -1, 0, 584, 0 },
+    { -1, 0, 585, 0 },
+    { 8, 293, 1078, 1079 },
+    { -1, 0, 586, 0 },
+    { -1, 0, 587, 0 },
+    { 14, 119, 1081, 1086 },
+    { 2, 51, 1082, 1083 },
+    { -1, 0, 588, 0 },
+    { 8, 326, 1084, 1085 },
+    { -1, 0, 589, 0 },
+    { -1, 0, 590, 0 },
+    { 13, 110, 1087, 1092 },
+    { 4, 59, 1088, 1091 },
+    { 13, 93, 1089, 1090 },
+    { -1, 0, 591, 0 },
+    { -1, 0, 592, 0 },
+    { -1, 0, 593, 0 },
+    { -1, 0, 594, 0 },
+    { 16, 126, 1094, 1099 },
+    { 16, 58, 1095, 1096 },
+    { -1, 0, 595, 0 },
+    { 7, 349, 1097, 1098 },
+    { -1, 0, 596, 0 },
+    { -1, 0, 597, 0 },
+    { 5, 19, 1100, 1105 },
+    { 17, 417, 1101, 1104 },
+    { 1, 21, 1102, 1103 },
+    { -1, 0, 598, 0 },
+    { -1, 0, 599, 0 },
+    { -1, 0, 600, 0 },
+    { -1, 0, 601, 0 },
+    { 0, 544, 1107, 1114 },
+    { 6, 271, 1108, 1113 },
+    { 13, 104, 1109, 1112 },
+    { 13, 52, 1110, 1111 },
+    { -1, 0, 602, 0 },
+    { -1, 0, 603, 0 },
+    { -1, 0, 604, 0 },
+    { -1, 0, 605, 0 },
+    { 1, 155, 1115, 1116 },
+    { -1, 0, 606, 0 },
+    { -1, 0, 607, 0 },
+    { 13, 38, 1118, 1123 },
+    { 17, 88, 1119, 1120 },
+    { -1, 0, 608, 0 },
+    { 0, 544, 1121, 1122 },
+    { -1, 0, 609, 0 },
+    { -1, 0, 610, 0 },
+    { 11, 8, 1124, 1129 },
+    { 4, 30, 1125, 1128 },
+    { 10, 4, 1126, 1127 },
+    { -1, 0, 611, 0 },
+    { -1, 0, 612, 0 },
+    { -1, 0, 613, 0 },
+    { -1, 0, 614, 0 },
+};
+
+// Probabilidad de cada clase en cada hoja (x255)
+static const uint8_t model_leaf_proba[615][MODEL_NUM_CLASSES] = {
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 0, 255, 0 },
+    { 0, 0, 0, 255, 0, 0 },
+    { 0, 255, 0, 0, 0, 0 },
+    { 0, 0, 255, 0, 0, 0 },
+    { 0, 0, 0, 0, 0, 255 },
+    { 255, 0, 0, 0, 0, 0 },
+};
+
+// Detector de novedad: media de cada clase (cuentas), matriz de blanqueo (Q16)
+// y umbral de la distancia de Mahalanobis al cuadrado (Q16)
+static const int32_t model_novelty_mean[MODEL_NUM_CLASSES][18] = {
+    { 620, 149, 56, 38, 68, 24, 446, 557, 362, 96, 11, 9, 15, 46, 147, 126, 309, 496 },
+    { 74, 19, 14, 10, 12, 5, 112, 86, 42, 17, 4, 3, 7, 88, 412, 185, 228, 223 },
+    { 96, 23, 18, 12, 14, 5, 139, 108, 52, 21, 5, 4, 9, 120, 536, 242, 305, 295 },
+    { 547, 161, 52, 33, 56, 20, 146, 352, 327, 91, 7, 6, 10, 32, 92, 40, 59, 89 },
+    { 542, 160, 51, 33, 56, 20, 145, 349, 324, 90, 7, 6, 10, 32, 91, 39, 58, 89 },
+    { 408, 88, 46, 30, 49, 17, 402, 412, 222, 67, 10, 8, 15, 99, 445, 267, 430, 544 },
+};
+
+static const int32_t model_novelty_whiten[MODEL_NUM_CLASSES][18][18] = {
+    {
+        { 19606, -1347, -13339, -11961, -4989, -34559, -1338, -1199, -1394, -3715, -33653, 0, 0, 0, -253, -206, -805, -751 },
+        { 0, 68052, -31116, -36920, -7000, -27059, -779, -732, -1026, -7579, -3509, 0, 0, 0, -274, -147, -527, -401 },
+        { 0, 0, 186583, 2496, -42112, -10071, -1932, -2306, -2265, -43929, -42471, 0, 0, 0, -725, -80, -356, -1453 },
+        { 0, 0, 0, 279378, 559, -214132, -1477, -1733, -2475, -2634, 13680, 0, 0, 0, -314, -1137, -767, -699 },
+        { 0, 0, 0, 0, 165329, -4701, -1041, -1218, -617, -22174, -112983, 0, 0, 0, -126, -96, 184, -1006 },
+        { 0, 0, 0, 0, 0, 208489, -7540, -7732, -7481, -9824, 53997, 0, 0, 0, -934, -7779, -4935, -4509 },
+        { 0, 0, 0, 0, 0, 0, 27597, -3876, -3908, -11416, -46171, 0, 0, 0, -587, -2468, -2258, -2298 },
+        { 0, 0, 0, 0, 0, 0, 0, 23951, -5149, -15407, -51854, 0, 0, 0, -725, -3309, -2861, -2943 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 30738, -13637, -42039, 0, 0, 0, -1005, -3058, -3006, -2829 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 106687, -69128, 0, 0, 0, -875, -1987, -1694, -3173 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 241410, 0, 0, 0, -966, -7819, -4858, -4826 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2156082, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1453212, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 113934, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 21584, -1139, -1192, -1080 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 41212, -2704, -2668 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 26055, -3568 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 18557 },
+    },
+    {
+        { 6192, -68, -526, -647, -391, -1305, -67, -42, -30, -244, -11200, 0, -7920, -817, -131, -210, -124, -72 },
+        { 0, 21609, -452, -555, -254, -1120, -69, -44, -31, -327, -9616, 0, -6800, -847, -132, -208, -124, -73 },
+        { 0, 0, 80779, -1631, -667, -3291, -140, -86, -56, -437, -28247, 0, -19974, -1701, -256, -423, -243, -144 },
+        { 0, 0, 0, 127059, -530, -2614, -111, -68, -44, -347, -22441, 0, -15869, -1351, -204, -336, -193, -115 },
+        { 0, 0, 0, 0, 62447, -2198, -114, -72, -58, -325, -18863, 0, -13338, -1404, -232, -363, -223, -125 },
+        { 0, 0, 0, 0, 0, 179490, -161, -99, -65, -504, -32604, 0, -23055, -1966, -296, -489, -281, -167 },
+        { 0, 0, 0, 0, 0, 0, 9054, -103, -71, -622, -28050, 0, -19835, -2009, -313, -500, -296, -173 },
+        { 0, 0, 0, 0, 0, 0, 0, 8135, -51, -445, -19553, 0, -13826, -1422, -220, -353, -209, -122 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 10281, -250, -10194, 0, -7208, -790, -125, -197, -118, -68 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 40749, -20179, 0, -14269, -1739, -270, -427, -255, -149 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 478976, 0, -78209, -6725, -1015, -1672, -962, -571 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 662994, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 408754, -6859, -1035, -1705, -982, -582 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 30053, -1657, -2680, -1570, -922 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5894, -2871, -1689, -987 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 11839, -1764, -1040 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7696, -1172 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 6089 },
+    },
+    {
+        { 105773, 0, 0, -26839, 0, 0, -26959, 2969, 0, 0, 0, 0, 0, 14044, -3179, -28197, -4419, -2801 },
+        { 0, 390311, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 1467946, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 250779, 0, 0, -27450, 14356, 0, 0, 0, 0, 0, -80964, -3663, -8468, -20893, -6252 },
+        { 0, 0, 0, 0, 1135965, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 3269334, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 139502, 8283, 0, 0, 0, 0, 0, 9890, -6566, -53508, -12236, -6380 },
+        { 0, 0, 0, 0, 0, 0, 0, 120788, 0, 0, 0, 0, 0, 11799, -1315, -14393, -16913, -9583 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 185587, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 740417, 0, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9578539, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 11950366, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8054617, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 189425, -18869, -31660, -6944, -14700 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 73424, -24329, -72865, -19805 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 135309, -45432, -33155 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 82404, -44246 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 62058 },
+    },
+    {
+        { 71211, 384, 0, -10395, 3253, -20970, 0, -50, -21195, 5604, 0, 0, 0, 0, -1326, -14253, 0, 0 },
+        { 0, 261322, 0, -14478, -173112, -29207, 0, 0, -46, -36961, 0, 0, 0, 0, -3, -24, 0, 0 },
+        { 0, 0, 1020533, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 1314555, -26286, -1278040, 0, -8, -2014, -5612, 0, 0, 0, 0, -134, -1069, 0, 0 },
+        { 0, 0, 0, 0, 458077, -225510, 0, -1, -355, -192895, 0, 0, 0, 0, -24, -189, 0, 0 },
+        { 0, 0, 0, 0, 0, 304374, 0, -108, -26268, -215378, 0, 0, 0, 0, -1752, -13938, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 114507, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 100832, -326, -235, 0, 0, 0, 0, -1420, -1775, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 103859, -55469, 0, 0, 0, 0, -3966, -23176, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 223197, 0, 0, 0, 0, -2709, -19456, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 6659107, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8308028, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5599660, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 439021, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 77099, -9148, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 106355, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 108259, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 82911 },
+    },
+    {
+        { 59042, -10297, -2180, -5361, 0, -10815, -6731, -1466, -2363, -555, 0, 0, 0, 0, -994, 0, -15, -6812 },
+        { 0, 170480, 1085, 2669, 0, 5384, -12275, -14805, -23487, 276, 0, 0, 0, 0, -10032, 0, 7, -4469 },
+        { 0, 0, 765484, -243561, 0, -491324, -146, 55, -1495, -25200, 0, 0, 0, 0, 38, 0, -663, -204 },
+        { 0, 0, 0, 1053330, 0, -991576, -294, 112, -3018, -50858, 0, 0, 0, 0, 76, 0, -1338, -412 },
+        { 0, 0, 0, 0, 629528, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 438692, -2086, 795, -21437, -361289, 0, 0, 0, 0, 538, 0, -9506, -2930 },
+        { 0, 0, 0, 0, 0, 0, 82521, -5793, -9806, -9704, 0, 0, 0, 0, -3925, 0, -255, -6775 },
+        { 0, 0, 0, 0, 0, 0, 0, 77783, -12308, 3198, 0, 0, 0, 0, -5339, 0, 84, -2719 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 91562, -90464, 0, 0, 0, 0, -7802, 0, -2380, -4850 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 146350, 0, 0, 0, 0, -3554, 0, -26419, -11072 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5308223, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 6622639, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4463698, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 349960, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 64275, 0, -1674, -3657 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 132524, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 76436, -4465 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 60022 },
+    },
+    {
+        { 41685, -6922, 1882, -20546, 4390, -14662, -6118, -5431, -3074, -2126, 0, 0, 0, -17074, -2715, -6662, -3267, -5446 },
+        { 0, 140154, -86564, 35040, 31220, 9006, -6811, -5579, -4703, 3625, 0, 0, 0, -968, -2946, -6630, -3891, -3442 },
+        { 0, 0, 211420, -71318, -66209, -22864, -5507, -2762, -8151, -7379, 0, 0, 0, 28802, 277, -5128, 1702, -1260 },
+        { 0, 0, 0, 385224, -30861, 92013, -4058, -1688, -7564, -179661, 0, 0, 0, -20097, -5686, -8188, -6199, -563 },
+        { 0, 0, 0, 0, 205614, -140514, -18, -1725, 2115, -32947, 0, 0, 0, 19062, -3105, -4814, -11879, 1525 },
+        { 0, 0, 0, 0, 0, 202760, -3351, 2087, -7777, 76785, 0, 0, 0, -26442, -1097, -1821, -6707, -4529 },
+        { 0, 0, 0, 0, 0, 0, 56109, -12091, -8762, -11301, 0, 0, 0, -9091, -6591, -12097, -8525, -6939 },
+        { 0, 0, 0, 0, 0, 0, 0, 49471, -10446, -14641, 0, 0, 0, -20579, -7015, -11804, -8258, -8370 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 65181, -19109, 0, 0, 0, -17960, -5733, -7202, -7902, -6099 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 193484, 0, 0, 0, -12923, -8027, -11698, -8298, -223 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3761965, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4693498, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3163445, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 156188, -5083, -16453, -10501, -12677 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 40108, -16748, -20631, -8330 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 73248, -19473, -16906 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 37919, -28043 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 14269 },
+    },
+};
+
+static const uint32_t model_novelty_threshold[MODEL_NUM_CLASSES] = {
+    2772986, 4023534, 2772986, 2772986, 2772986, 2772986,
+};
+
+#endif // CLASSIFIER_MODEL_H
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "dlog.h"
+
+#if CONFIG_DLOG_DEFERRED
+
+static dlog_record_t records[CONFIG_DLOG_RING_LEN];
+static uint32_t written = 0;  // Total de registros escritos (el índice es written % LEN)
+static portMUX_TYPE dlog_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void dlog_write(uint8_t level, uint16_t id, uint8_t nargs, const uint32_t *args) {
+    uint32_t ts = (uint32_t)esp_timer_get_time();
+
+    portENTER_CRITICAL(&dlog_lock);
+    dlog_record_t *r = &records[written % CONFIG_DLOG_RING_LEN];
+    r->ts_us = ts;
+    r->id = id;
+    r->level = level;
+    r->nargs = nargs;
+    memcpy(r->args, args, nargs * sizeof(uint32_t));
+    written++;
+    portEXIT_CRITICAL(&dlog_lock);
+}
+
+esp_err_t dlog_dump(dlog_sink_t sink, void *ctx) {
+    static dlog_record_t copy[CONFIG_DLOG_RING_LEN];
+    uint8_t header[12];
+    uint32_t count, first;
+
+    // Copia bajo el cerrojo para no retener a las tareas durante el envío
+    portENTER_CRITICAL(&dlog_lock);
+    count = written < CONFIG_DLOG_RING_LEN ? written : CONFIG_DLOG_RING_LEN;
+    first = written - count;
+    for (uint32_t i = 0; i < count; i++) {
+        copy[i] = records[(first + i) % CONFIG_DLOG_RING_LEN];
+    }
+    portEXIT_CRITICAL(&dlog_lock);
+
+    memcpy(header, DLOG_MAGIC, 4);
+    header[4] = DLOG_VERSION & 0xFF;
+    header[5] = DLOG_VERSION >> 8;
+    header[6] = sizeof(dlog_record_t) & 0xFF;
+    header[7] = sizeof(dlog_record_t) >> 8;
+    memcpy(&header[8], &count, sizeof(count));
+
+    esp_err_t err = sink(ctx, (const char *)header, sizeof(header));
+    if (err == ESP_OK && count > 0) {
+        err = sink(ctx, (const char *)copy, count * sizeof(dlog_record_t));
+    }
+    return err;
+}
+
+#else
+
+#define DLOG_STRING(id, fmt) fmt,
+static const char *const formats[DLOG_FORMAT_COUNT] = {
+    DLOG_FORMATS(DLOG_STRING)
+};
+#undef DLOG_STRING
+
+// Sin anillo: se formatea y se imprime en el momento
+void dlog_write(uint8_t level, uint16_t id, uint8_t nargs, const uint32_t *args) {
+    uint32_t a[DLOG_MAX_ARGS] = {0};
+
+    memcpy(a, args, nargs * sizeof(uint32_t));
+    printf(formats[id], a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]);
+    printf("\n");
+}
+
+esp_err_t dlog_dump(dlog_sink_t sink, void *ctx) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif // CONFIG_DLOG_DEFERRED
+
+// Volcado por UART: líneas "DLOG <hex>" entre DLOG_BEGIN y DLOG_END
+static esp_err_t uart_sink(void *ctx, const char *data, size_t len) {
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    while (len > 0) {
+        size_t n = len < 32 ? len : 32;
+        printf("DLOG ");
+        for (size_t i = 0; i < n; i++) {
+            printf("%02x", bytes[i]);
+        }
+        printf("\n");
+        bytes += n;
+        len -= n;
+    }
+    return ESP_OK;
+}
+
+void dlog_dump_uart(void) {
+    printf("DLOG_BEGIN\n");
+    dlog_dump(uart_sink, NULL);
+    printf("DLOG_END\n");
+    fflush(stdout);
+}
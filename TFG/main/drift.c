@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "nvs.h"
+#include "drift.h"
+
+static const char *TAG = "drift";
+
+#define NVS_NAMESPACE "drift"
+#define NVS_KEY       "coef"
+
+typedef struct {
+    int32_t tref;
+    int32_t k_ppm[SAMPLE_CHANNELS];
+} drift_coef_t;
+
+static drift_coef_t coef = { .tref = CONFIG_DRIFT_REF_TEMP };
+static bool enabled = false;   // Algún coeficiente distinto de 0
+static bool loaded = false;    // Carga perezosa desde la primera tarea de adquisición
+static portMUX_TYPE drift_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static bool any_coefficient(const drift_coef_t *c) {
+    for (int i = 0; i < SAMPLE_CHANNELS; i++) {
+        if (c->k_ppm[i] != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Primera trama: coeficientes guardados en NVS, si los hay
+static void load_coef(void) {
+    drift_coef_t stored;
+    size_t size = sizeof(stored);
+    nvs_handle_t nvs;
+
+    loaded = true;
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK) {
+        return;
+    }
+    if (nvs_get_blob(nvs, NVS_KEY, &stored, &size) == ESP_OK && size == sizeof(stored)) {
+        portENTER_CRITICAL(&drift_lock);
+        coef = stored;
+        enabled = any_coefficient(&stored);
+        portEXIT_CRITICAL(&drift_lock);
+        ESP_LOGI(TAG, "Coeficientes de deriva cargados (Tref %d °C)", (int)stored.tref);
+    }
+    nvs_close(nvs);
+}
+
+esp_err_t drift_set(int tref, const int32_t k_ppm[SAMPLE_CHANNELS]) {
+    drift_coef_t c = { .tref = tref };
+    nvs_handle_t nvs;
+
+    memcpy(c.k_ppm, k_ppm, sizeof(c.k_ppm));
+    portENTER_CRITICAL(&drift_lock);
+    coef = c;
+    enabled = any_coefficient(&c);
+    portEXIT_CRITICAL(&drift_lock);
+
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(nvs, NVS_KEY, &c, sizeof(c));
+        if (err == ESP_OK) {
+            err = nvs_commit(nvs);
+        }
+        nvs_close(nvs);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "No se pudieron guardar los coeficientes: %s", esp_err_to_name(err));
+    }
+    return err;
+}
+
+void drift_get(int *tref, int32_t k_ppm[SAMPLE_CHANNELS]) {
+    portENTER_CRITICAL(&drift_lock);
+    *tref = coef.tref;
+    memcpy(k_ppm, coef.k_ppm, sizeof(coef.k_ppm));
+    portEXIT_CRITICAL(&drift_lock);
+}
+
+void drift_compensate(sample_frame_t *frame) {
+    drift_coef_t c;
+    bool on;
+
+    if (!loaded) {
+        load_coef();
+    }
+
+    portENTER_CRITICAL(&drift_lock);
+    on = enabled;
+    c = coef;
+    portEXIT_CRITICAL(&drift_lock);
+
+    if (!on) {
+        return;
+    }
+
+    // raw(Tref) = raw(T) * 10^6 / (10^6 + k * dT), en enteros de 64 bits
+    for (int i = 0; i < SAMPLE_CHANNELS; i++) {
+        int32_t dt = frame->die_temperature[i / 6] - c.tref;
+        int64_t den = DRIFT_PPM + (int64_t)c.k_ppm[i] * dt;
+        if (den < DRIFT_PPM / 2) {
+            continue;  // Fuera del rango en que el modelo lineal tiene sentido
+        }
+        int64_t v = ((int64_t)frame->values[i] * DRIFT_PPM + den / 2) / den;
+        frame->values[i] = v > UINT16_MAX ? UINT16_MAX : v;
+    }
+}
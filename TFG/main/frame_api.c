@@ -0,0 +1,256 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <ctype.h>
+#include <time.h>
+#include "esp_log.h"
+#include "esp_http_server.h"
+#include "sample_ring.h"
+#include "frame_api.h"
+
+static const char *TAG = "frame_api";
+
+#define FRAMES_DEFAULT_LIMIT 100
+#define CHUNK_SIZE 1024        // Tamaño del bloque enviado con httpd_resp_send_chunk
+#define JSON_FRAME_MAX 280     // Peor caso de una trama en JSON
+#define CSV_ROW_MAX 128        // Peor caso de una fila del CSV
+
+// Lee los parámetros since (ms desde epoch), limit y head (cabezal; -1 = todos) de la URL
+static void parse_range_query(httpd_req_t *req, int64_t *since, int *limit, int *head, int default_limit,
+                              int default_head) {
+    char query[96], value[24];
+
+    *since = -1;
+    *limit = default_limit;
+    *head = default_head;
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) != ESP_OK) {
+        return;
+    }
+    if (httpd_query_key_value(query, "since", value, sizeof(value)) == ESP_OK) {
+        *since = strtoll(value, NULL, 10);
+    }
+    if (httpd_query_key_value(query, "limit", value, sizeof(value)) == ESP_OK) {
+        *limit = atoi(value);
+    }
+    if (httpd_query_key_value(query, "head", value, sizeof(value)) == ESP_OK) {
+        *head = atoi(value);
+    }
+    if (*limit <= 0 || *limit > CONFIG_SAMPLE_RING_LEN) {
+        *limit = CONFIG_SAMPLE_RING_LEN;
+    }
+}
+
+static int format_frame_json(const sample_frame_t *frame, bool first, char *out, size_t len) {
+    int n = snprintf(out, len, "%s{\"seq\":%" PRIu32 ",\"ts\":%" PRId64 ",\"head\":%u,\"temperature\":%d,\"temperatures\":[%d,%d,%d],\"values\":[",
+                     first ? "" : ",", frame->seq, frame->timestamp_ms, frame->head, frame->temperature,
+                     frame->die_temperature[0], frame->die_temperature[1], frame->die_temperature[2]);
+    for (int i = 0; i < SAMPLE_CHANNELS; i++) {
+        n += snprintf(out + n, len - n, i ? ",%u" : "%u", frame->values[i]);
+    }
+    n += snprintf(out + n, len - n, "]");
+    if (frame->trigger_id != 0) {
+        n += snprintf(out + n, len - n, ",\"trigger\":%" PRIu32, frame->trigger_id);
+    }
+    n += snprintf(out + n, len - n, "}");
+    return n;
+}
+
+// GET /api/frames?since=<ts>&limit=N&head=H
+// Sin head, las de todos los cabezales. Las tramas se sacan del anillo de una en una y se envían en bloques, de modo
+// que la respuesta completa nunca se construye en RAM.
+static esp_err_t frames_json_handler(httpd_req_t *req) {
+    static char chunk[CHUNK_SIZE];  // httpd atiende una petición a la vez
+    int64_t since;
+    int limit, head, used, sent = 0;
+
+    parse_range_query(req, &since, &limit, &head, FRAMES_DEFAULT_LIMIT, -1);
+    httpd_resp_set_type(req, "application/json");
+
+    used = snprintf(chunk, sizeof(chunk), "{\"channels\":\"RSTUVWGHIJKLABCDEF\",\"frames\":[");
+    uint32_t seq = since < 0 ? sample_ring_oldest_seq() : sample_ring_find_after(since);
+    for (; sent < limit && seq != sample_ring_next_seq(); seq++) {
+        // Se envía antes de tomar la trama: solo se retiene mientras se formatea
+        if (used + JSON_FRAME_MAX > sizeof(chunk)) {
+            if (httpd_resp_send_chunk(req, chunk, used) != ESP_OK) {
+                ESP_LOGW(TAG, "Cliente desconectado durante /api/frames");
+                return ESP_FAIL;
+            }
+            used = 0;
+        }
+        const sample_frame_t *frame = sample_ring_acquire(seq);
+        if (frame == NULL) {
+            seq = sample_ring_oldest_seq() - 1;  // Sobrescrita mientras enviábamos
+            continue;
+        }
+        if ((head >= 0 && frame->head != head) || frame->timestamp_ms <= since) {
+            sample_ring_release(frame);
+            continue;
+        }
+        used += format_frame_json(frame, sent == 0, chunk + used, sizeof(chunk) - used);
+        sample_ring_release(frame);
+        sent++;
+    }
+    used += snprintf(chunk + used, sizeof(chunk) - used, "],\"count\":%d}", sent);
+
+    if (httpd_resp_send_chunk(req, chunk, used) != ESP_OK) {
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+// GET /api/frames.bin?since=<ts>&limit=N&head=H
+// Tramas consecutivas de SAMPLE_FRAME_WIRE_SIZE bytes (mismo formato que /ws/spectrum)
+static esp_err_t frames_bin_handler(httpd_req_t *req) {
+    static uint8_t chunk[(CHUNK_SIZE / SAMPLE_FRAME_WIRE_SIZE) * SAMPLE_FRAME_WIRE_SIZE];
+    int64_t since;
+    int limit, head, sent = 0;
+    size_t used = 0;
+
+    parse_range_query(req, &since, &limit, &head, FRAMES_DEFAULT_LIMIT, -1);
+    httpd_resp_set_type(req, "application/octet-stream");
+
+    uint32_t seq = since < 0 ? sample_ring_oldest_seq() : sample_ring_find_after(since);
+    for (; sent < limit && seq != sample_ring_next_seq(); seq++) {
+        if (used + SAMPLE_FRAME_WIRE_SIZE > sizeof(chunk)) {
+            if (httpd_resp_send_chunk(req, (const char *)chunk, used) != ESP_OK) {
+                ESP_LOGW(TAG, "Cliente desconectado durante /api/frames.bin");
+                return ESP_FAIL;
+            }
+            used = 0;
+        }
+        const sample_frame_t *frame = sample_ring_acquire(seq);
+        if (frame == NULL) {
+            seq = sample_ring_oldest_seq() - 1;
+            continue;
+        }
+        if ((head >= 0 && frame->head != head) || frame->timestamp_ms <= since) {
+            sample_ring_release(frame);
+            continue;
+        }
+        used += sample_frame_pack(frame, chunk + used);
+        sample_ring_release(frame);
+        sent++;
+    }
+
+    if (used > 0 && httpd_resp_send_chunk(req, (const char *)chunk, used) != ESP_OK) {
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+// Decodifica la etiqueta de la URL y la normaliza como hace app.py
+// (minúsculas, sin espacios en los extremos y sin caracteres raros para el nombre de fichero)
+static void sanitize_label(const char *in, char *out, size_t len) {
+    size_t n = 0;
+
+    while (*in == ' ' || *in == '+') {
+        in++;
+    }
+    while (*in && n < len - 1) {
+        char c = *in++;
+        if (c == '+') {
+            c = ' ';
+        } else if (c == '%' && isxdigit((unsigned char)in[0]) && isxdigit((unsigned char)in[1])) {
+            char hex[3] = { in[0], in[1], '\0' };
+            c = (char)strtol(hex, NULL, 16);
+            in += 2;
+        }
+        if (isalnum((unsigned char)c) || c == ' ' || c == '-' || c == '_') {
+            out[n++] = tolower((unsigned char)c);
+        } else if ((unsigned char)c >= 0x80) {
+            out[n++] = c;  // Letras UTF-8 (ñ, tildes...)
+        } else {
+            out[n++] = '_';
+        }
+    }
+    while (n > 0 && out[n - 1] == ' ') {
+        n--;
+    }
+    out[n] = '\0';
+    if (n == 0) {
+        strncpy(out, "material_desconocido", len - 1);
+        out[len - 1] = '\0';
+    }
+}
+
+// Una fila del CSV de entrenamiento: timestamp,R,S,T,U,V,W,G,H,I,J,K,L,A,B,C,D,E,F
+static int format_frame_csv(const sample_frame_t *frame, char *out, size_t len) {
+    time_t seconds = frame->timestamp_ms / 1000;
+    struct tm timeinfo;
+
+    localtime_r(&seconds, &timeinfo);
+    int n = strftime(out, len, "%Y-%m-%d %H:%M:%S", &timeinfo);
+    for (int i = 0; i < SAMPLE_CHANNELS; i++) {
+        n += snprintf(out + n, len - n, ",%u", frame->values[i]);
+    }
+    n += snprintf(out + n, len - n, "\n");
+    return n;
+}
+
+// GET /export.csv?label=<material>[&since=<ts>&limit=N&head=H]
+// Descarga las tramas del anillo con el formato de datos_materiales/espectroscopia_<material>.csv.
+// Solo las de un cabezal (por defecto el 0): cada uno tiene su calibración y no se mezclan.
+// Memoria constante: una fila se formatea directamente en el bloque que se está llenando.
+static esp_err_t export_csv_handler(httpd_req_t *req) {
+    static char chunk[CHUNK_SIZE];
+    static char disposition[96];  // httpd guarda el puntero hasta enviar la cabecera
+    char query[96], value[48], label[48];
+    int64_t since;
+    int limit, head, used;
+
+    parse_range_query(req, &since, &limit, &head, CONFIG_SAMPLE_RING_LEN, 0);
+    value[0] = '\0';
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        httpd_query_key_value(query, "label", value, sizeof(value));
+    }
+    sanitize_label(value, label, sizeof(label));
+    snprintf(disposition, sizeof(disposition), "attachment; filename=\"espectroscopia_%s.csv\"", label);
+
+    httpd_resp_set_type(req, "text/csv");
+    httpd_resp_set_hdr(req, "Content-Disposition", disposition);
+
+    used = snprintf(chunk, sizeof(chunk), "timestamp,R,S,T,U,V,W,G,H,I,J,K,L,A,B,C,D,E,F\n");
+    uint32_t seq = since < 0 ? sample_ring_oldest_seq() : sample_ring_find_after(since);
+    for (int sent = 0; sent < limit && seq != sample_ring_next_seq(); seq++) {
+        if (used + CSV_ROW_MAX > sizeof(chunk)) {
+            if (httpd_resp_send_chunk(req, chunk, used) != ESP_OK) {
+                ESP_LOGW(TAG, "Cliente desconectado durante /export.csv");
+                return ESP_FAIL;
+            }
+            used = 0;
+        }
+        const sample_frame_t *frame = sample_ring_acquire(seq);
+        if (frame == NULL) {
+            seq = sample_ring_oldest_seq() - 1;
+            continue;
+        }
+        if (frame->head != head || frame->timestamp_ms <= since) {
+            sample_ring_release(frame);
+            continue;
+        }
+        used += format_frame_csv(frame, chunk + used, sizeof(chunk) - used);
+        sample_ring_release(frame);
+        sent++;
+    }
+
+    if (httpd_resp_send_chunk(req, chunk, used) != ESP_OK) {
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+esp_err_t frame_api_register(httpd_handle_t server) {
+    httpd_uri_t uri_json = { .uri = "/api/frames", .method = HTTP_GET, .handler = frames_json_handler };
+    httpd_uri_t uri_bin = { .uri = "/api/frames.bin", .method = HTTP_GET, .handler = frames_bin_handler };
+    httpd_uri_t uri_csv = { .uri = "/export.csv", .method = HTTP_GET, .handler = export_csv_handler };
+
+    esp_err_t err = httpd_register_uri_handler(server, &uri_json);
+    if (err == ESP_OK) {
+        err = httpd_register_uri_handler(server, &uri_bin);
+    }
+    if (err == ESP_OK) {
+        err = httpd_register_uri_handler(server, &uri_csv);
+    }
+    return err;
+}
@@ -0,0 +1,362 @@
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "driver/i2c.h"
+#include "driver/gpio.h"
+#include "esp_rom_sys.h"
+#include "mqtt_client.h"
+#include "esp_netif_sntp.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "hal.h"
+#include "heap_guard.h"
+#if CONFIG_AS7265X_SIMULATED
+#include "sim.h"
+#endif
+
+#define LED_GPIO GPIO_NUM_2           // LED conectado al pin G2
+
+#define AS7265X_ADDR 0x49
+#define SSD1306_ADDR 0x3C
+#define TCA9548A_ADDR_MIN 0x70
+#define TCA9548A_ADDR_MAX 0x77
+
+static const char *TAG = "hal_esp32";
+
+// ---------------------------------------------------------------------------
+// I2C
+
+// Los comandos se construyen en un búfer en la pila (i2c_cmd_link_create_static)
+// en lugar de con i2c_cmd_link_create, que reserva memoria en cada transacción
+#define I2C_CMD_BUF_SIZE I2C_LINK_RECOMMENDED_SIZE(1)
+
+// Configuración de cada puerto, para reinstalar el driver tras recuperar el
+// bus. bus_locks impide que otra tarea (p. ej. la pantalla) use el puerto
+// mientras el driver está desinstalado.
+static i2c_config_t port_config[HAL_I2C_PORTS];
+static SemaphoreHandle_t bus_locks[HAL_I2C_PORTS];
+
+#define BUS_LOCK(port) xSemaphoreTake(bus_locks[port], portMAX_DELAY)
+#define BUS_UNLOCK(port) xSemaphoreGive(bus_locks[port])
+
+esp_err_t hal_i2c_init(uint8_t port, int sda_io, int scl_io, uint32_t freq_hz) {
+    port_config[port] = (i2c_config_t){
+        .mode = I2C_MODE_MASTER,
+        .sda_io_num = sda_io,
+        .scl_io_num = scl_io,
+        .sda_pullup_en = GPIO_PULLUP_ENABLE,
+        .scl_pullup_en = GPIO_PULLUP_ENABLE,
+        .master.clk_speed = freq_hz,
+    };
+    bus_locks[port] = xSemaphoreCreateMutex();
+
+    esp_err_t ret = i2c_param_config((i2c_port_t)port, &port_config[port]);
+    if (ret == ESP_OK) {
+        ret = i2c_driver_install((i2c_port_t)port, I2C_MODE_MASTER, 0, 0, 0);
+    }
+    return ret;
+}
+
+// Transacción con el bus del puerto tomado
+static esp_err_t cmd_begin(uint8_t port, i2c_cmd_handle_t cmd, uint32_t timeout_ms) {
+    if (bus_locks[port] == NULL) {
+        return ESP_ERR_INVALID_STATE;  // Puerto sin driver instalado
+    }
+    BUS_LOCK(port);
+    esp_err_t ret = i2c_master_cmd_begin((i2c_port_t)port, cmd, pdMS_TO_TICKS(timeout_ms));
+    BUS_UNLOCK(port);
+    return ret;
+}
+
+// Lectura de un registro: escritura de la dirección y lectura en dos transacciones
+esp_err_t hal_i2c_read_reg(uint8_t port, uint8_t addr, uint8_t reg, uint8_t *data) {
+    uint8_t cmd_buf[I2C_CMD_BUF_SIZE];
+    esp_err_t ret;
+#if CONFIG_AS7265X_SIMULATED
+    if (addr == AS7265X_ADDR) {
+        return as7265x_sim_read(port, reg, data);
+    }
+#endif
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(cmd_buf, sizeof(cmd_buf));
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write_byte(cmd, reg, true);
+    i2c_master_stop(cmd);
+    ret = cmd_begin(port, cmd, 1000);
+    i2c_cmd_link_delete_static(cmd);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    cmd = i2c_cmd_link_create_static(cmd_buf, sizeof(cmd_buf));
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_READ, true);
+    i2c_master_read_byte(cmd, data, I2C_MASTER_NACK);
+    i2c_master_stop(cmd);
+    ret = cmd_begin(port, cmd, 1000);
+    i2c_cmd_link_delete_static(cmd);
+    return ret;
+}
+
+// Escritura de len bytes a partir del registro (o byte de control) reg
+esp_err_t hal_i2c_write(uint8_t port, uint8_t addr, uint8_t reg, const uint8_t *data, size_t len) {
+#if CONFIG_AS7265X_SIMULATED
+    // Sin bus real: el sensor es el modelo, el multiplexor solo elige la
+    // instancia simulada y la pantalla no existe
+    if (addr == AS7265X_ADDR) {
+        for (size_t i = 0; i < len; i++) {
+            as7265x_sim_write(port, reg, data[i]);
+        }
+        return ESP_OK;
+    }
+    if (addr >= TCA9548A_ADDR_MIN && addr <= TCA9548A_ADDR_MAX) {
+        as7265x_sim_mux_select(port, reg);
+        return ESP_OK;
+    }
+    if (addr == SSD1306_ADDR) {
+        return ESP_OK;
+    }
+#endif
+    uint8_t cmd_buf[I2C_CMD_BUF_SIZE];
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(cmd_buf, sizeof(cmd_buf));
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write_byte(cmd, reg, true);
+    if (len > 0) {
+        i2c_master_write(cmd, data, len, true);
+    }
+    i2c_master_stop(cmd);
+    esp_err_t ret = cmd_begin(port, cmd, 1000);
+    i2c_cmd_link_delete_static(cmd);
+    return ret;
+}
+
+// Solo la dirección con bit de escritura: basta con que el dispositivo haga ACK
+esp_err_t hal_i2c_probe(uint8_t port, uint8_t addr, uint32_t timeout_ms) {
+#if CONFIG_AS7265X_SIMULATED
+    if (addr == AS7265X_ADDR || addr == SSD1306_ADDR || (addr >= TCA9548A_ADDR_MIN && addr <= TCA9548A_ADDR_MAX)) {
+        return ESP_OK;
+    }
+#endif
+    uint8_t cmd_buf[I2C_CMD_BUF_SIZE];
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(cmd_buf, sizeof(cmd_buf));
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_stop(cmd);
+    esp_err_t ret = cmd_begin(port, cmd, timeout_ms);
+    i2c_cmd_link_delete_static(cmd);
+    return ret;
+}
+
+// Un esclavo que se quedó a mitad de un byte (p. ej. por un reset del
+// maestro) mantiene SDA a nivel bajo y el bus no admite un START. Se libera
+// con hasta 9 pulsos de SCL a mano hasta que suelte SDA y una condición de
+// STOP, y después se reinstala el driver.
+#define RECOVERY_CLOCKS 9
+#define RECOVERY_HALF_PERIOD_US 5  // 100 kHz
+
+esp_err_t hal_i2c_bus_recover(uint8_t port) {
+#if CONFIG_AS7265X_SIMULATED
+    as7265x_sim_bus_recover(port);
+    return ESP_OK;
+#else
+    const i2c_config_t *conf = &port_config[port];
+    gpio_num_t sda = conf->sda_io_num;
+    gpio_num_t scl = conf->scl_io_num;
+    esp_err_t ret;
+
+    if (bus_locks[port] == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    BUS_LOCK(port);
+    // Se llama desde sensor_task: reinstalar el driver reserva memoria
+    heap_guard_allow_begin();
+    i2c_driver_delete((i2c_port_t)port);
+
+    gpio_set_direction(sda, GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_direction(scl, GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_pull_mode(sda, GPIO_PULLUP_ONLY);
+    gpio_set_pull_mode(scl, GPIO_PULLUP_ONLY);
+    gpio_set_level(sda, 1);
+    gpio_set_level(scl, 1);
+    esp_rom_delay_us(RECOVERY_HALF_PERIOD_US);
+
+    int clocks = 0;
+    while (clocks < RECOVERY_CLOCKS && gpio_get_level(sda) == 0) {
+        gpio_set_level(scl, 0);
+        esp_rom_delay_us(RECOVERY_HALF_PERIOD_US);
+        gpio_set_level(scl, 1);
+        esp_rom_delay_us(RECOVERY_HALF_PERIOD_US);
+        clocks++;
+    }
+
+    // STOP: SDA sube con SCL alto
+    gpio_set_level(scl, 0);
+    gpio_set_level(sda, 0);
+    esp_rom_delay_us(RECOVERY_HALF_PERIOD_US);
+    gpio_set_level(scl, 1);
+    esp_rom_delay_us(RECOVERY_HALF_PERIOD_US);
+    gpio_set_level(sda, 1);
+    esp_rom_delay_us(RECOVERY_HALF_PERIOD_US);
+    bool released = gpio_get_level(sda) == 1;
+
+    ret = i2c_param_config((i2c_port_t)port, conf);
+    if (ret == ESP_OK) {
+        ret = i2c_driver_install((i2c_port_t)port, I2C_MODE_MASTER, 0, 0, 0);
+    }
+    heap_guard_allow_end();
+    BUS_UNLOCK(port);
+
+    ESP_LOGW(TAG, "Bus I2C %d recuperado con %d pulsos de SCL, SDA %s", port, clocks,
+             released ? "libre" : "todavía retenida");
+    if (ret == ESP_OK && !released) {
+        ret = ESP_FAIL;
+    }
+    return ret;
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Entrada de disparo
+
+static hal_trigger_cb_t trigger_cb = NULL;
+
+static void trigger_isr_handler(void *arg) {
+    trigger_cb(esp_timer_get_time());
+}
+
+esp_err_t hal_trigger_init(int gpio, bool rising_edge, hal_trigger_cb_t cb) {
+    // Con pull-up la entrada admite también detectores de colector abierto
+    gpio_config_t conf = {
+        .pin_bit_mask = BIT64(gpio),
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = rising_edge ? GPIO_INTR_POSEDGE : GPIO_INTR_NEGEDGE,
+    };
+
+    trigger_cb = cb;
+    esp_err_t ret = gpio_config(&conf);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = gpio_install_isr_service(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {  // INVALID_STATE: ya instalado
+        return ret;
+    }
+    return gpio_isr_handler_add(gpio, trigger_isr_handler, NULL);
+}
+
+// ---------------------------------------------------------------------------
+// LED de estado
+
+void hal_led_init(void) {
+    gpio_reset_pin(LED_GPIO);
+    gpio_set_direction(LED_GPIO, GPIO_MODE_OUTPUT);
+}
+
+void hal_led_set_level(uint32_t level) {
+    gpio_set_level(LED_GPIO, level);
+}
+
+// ---------------------------------------------------------------------------
+// MQTT (esp-mqtt)
+
+static esp_mqtt_client_handle_t mqtt_client = NULL;
+static hal_mqtt_connection_cb_t connection_cb = NULL;
+static hal_mqtt_data_cb_t data_cb = NULL;
+static hal_mqtt_published_cb_t published_cb = NULL;
+
+static void mqtt_event_handler(void *handler_args, esp_event_base_t base, int32_t event_id, void *event_data) {
+    esp_mqtt_event_handle_t event = event_data;
+
+    switch (event->event_id) {
+        case MQTT_EVENT_CONNECTED:
+            connection_cb(true);
+            break;
+        case MQTT_EVENT_DISCONNECTED:
+            connection_cb(false);
+            break;
+        case MQTT_EVENT_DATA:
+            data_cb(event->topic, event->topic_len, event->data, event->data_len);
+            break;
+        case MQTT_EVENT_PUBLISHED:
+            published_cb(event->msg_id);
+            break;
+        default:
+            ESP_LOGI(TAG, "Evento MQTT: %d", event->event_id);
+            break;
+    }
+}
+
+void hal_mqtt_start(const char *uri, const char *username, hal_mqtt_connection_cb_t on_connection,
+                    hal_mqtt_data_cb_t on_data, hal_mqtt_published_cb_t on_published) {
+    esp_mqtt_client_config_t mqtt_cfg = {
+        .broker.address.uri = uri,
+        .credentials.username = username,
+    };
+
+    connection_cb = on_connection;
+    data_cb = on_data;
+    published_cb = on_published;
+    mqtt_client = esp_mqtt_client_init(&mqtt_cfg);
+    esp_mqtt_client_register_event(mqtt_client, ESP_EVENT_ANY_ID, mqtt_event_handler, NULL);
+    esp_mqtt_client_start(mqtt_client);
+}
+
+int hal_mqtt_publish(const char *topic, const char *data, int len, int qos) {
+    // esp-mqtt copia los mensajes QoS > 0 en su outbox con malloc hasta el PUBACK;
+    // con HEAP_GUARD se permite a las tareas vigiladas (publisher_task, sensor_task)
+    if (qos > 0) {
+        heap_guard_allow_begin();
+    }
+    int msg_id = esp_mqtt_client_publish(mqtt_client, topic, data, len, qos, 0);
+    if (qos > 0) {
+        heap_guard_allow_end();
+    }
+    return msg_id;
+}
+
+int hal_mqtt_subscribe(const char *topic, int qos) {
+    return esp_mqtt_client_subscribe(mqtt_client, topic, qos);
+}
+
+// Bytes pendientes de envío en el outbox del cliente MQTT
+int hal_mqtt_outbox_size(void) {
+    if (mqtt_client == NULL) {
+        return 0;
+    }
+    return esp_mqtt_client_get_outbox_size(mqtt_client);
+}
+
+// ---------------------------------------------------------------------------
+// Hora (SNTP)
+
+static volatile bool time_synced = false;
+
+static void time_sync_cb(struct timeval *tv) {
+    if (!time_synced) {
+        ESP_LOGI(TAG, "Hora sincronizada por SNTP");
+    }
+    time_synced = true;
+}
+
+void hal_time_sync_start(void) {
+    static bool started = false;
+
+    if (started) {
+        return;
+    }
+    started = true;
+    esp_sntp_config_t config = ESP_NETIF_SNTP_DEFAULT_CONFIG(CONFIG_SNTP_SERVER);
+    config.sync_cb = time_sync_cb;
+    esp_err_t err = esp_netif_sntp_init(&config);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "No se pudo arrancar SNTP: %s", esp_err_to_name(err));
+        started = false;
+    }
+}
+
+bool hal_time_synced(void) {
+    return time_synced;
+}
@@ -0,0 +1,87 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "heap_guard.h"
+
+#if CONFIG_HEAP_GUARD
+
+DRAM_ATTR static const char TAG[] = "heap_guard";
+
+// Tareas vigiladas (cada sensor_task y publisher_task) con la profundidad
+// de sus ventanas permitidas. Una entrada se ocupa una vez al armar y después
+// solo la modifica su propia tarea, así que el hook la lee sin cerrojo.
+#define MAX_GUARDED_TASKS 8
+
+typedef struct {
+    TaskHandle_t task;
+    int allow_depth;
+} guarded_task_t;
+
+static guarded_task_t guarded[MAX_GUARDED_TASKS];
+static portMUX_TYPE guard_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static IRAM_ATTR guarded_task_t *find_guarded(TaskHandle_t task) {
+    for (int i = 0; i < MAX_GUARDED_TASKS; i++) {
+        if (guarded[i].task == task) {
+            return &guarded[i];
+        }
+    }
+    return NULL;
+}
+
+void heap_guard_arm(void) {
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    bool armed = false;
+
+    if (find_guarded(task) != NULL) {
+        return;
+    }
+    taskENTER_CRITICAL(&guard_lock);
+    for (int i = 0; i < MAX_GUARDED_TASKS; i++) {
+        if (guarded[i].task == NULL) {
+            guarded[i].allow_depth = 0;
+            guarded[i].task = task;
+            armed = true;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL(&guard_lock);
+
+    if (armed) {
+        ESP_LOGI(TAG, "Vigilando reservas de memoria en la tarea %s", pcTaskGetName(task));
+    } else {
+        ESP_LOGW(TAG, "No se puede vigilar la tarea %s: ya hay %d", pcTaskGetName(task), MAX_GUARDED_TASKS);
+    }
+}
+
+void heap_guard_allow_begin(void) {
+    guarded_task_t *entry = find_guarded(xTaskGetCurrentTaskHandle());
+    if (entry != NULL) {
+        entry->allow_depth++;
+    }
+}
+
+void heap_guard_allow_end(void) {
+    guarded_task_t *entry = find_guarded(xTaskGetCurrentTaskHandle());
+    if (entry != NULL && entry->allow_depth > 0) {
+        entry->allow_depth--;
+    }
+}
+
+// Hook de heap_caps (CONFIG_HEAP_USE_HOOKS), se llama tras cada reserva
+void IRAM_ATTR esp_heap_trace_alloc_hook(void *ptr, size_t size, uint32_t caps) {
+    if (xPortInIsrContext()) {
+        return;
+    }
+    guarded_task_t *entry = find_guarded(xTaskGetCurrentTaskHandle());
+    if (entry == NULL || entry->allow_depth > 0) {
+        return;
+    }
+    ESP_DRAM_LOGE(TAG, "Reserva de %u bytes en el bucle de adquisición tras el calentamiento", (unsigned)size);
+    abort();
+}
+
+#endif // CONFIG_HEAP_GUARD
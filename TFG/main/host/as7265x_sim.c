@@ -0,0 +1,256 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "esp_log.h"
+#include "sim.h"
+
+static const char *TAG = "as7265x_sim";
+
+// Registros físicos
+#define SLAVE_STATUS_REG 0x00
+#define SLAVE_WRITE_REG  0x01
+#define SLAVE_READ_REG   0x02
+
+// Bits de STATUS
+#define STATUS_RX_VALID 0x01  // Hay un dato listo en READ
+#define STATUS_TX_VALID 0x02  // El sensor todavía está procesando la última escritura
+
+// Registros virtuales
+#define VREG_HW_VERSION_H 0x00
+#define VREG_HW_VERSION_L 0x01
+#define VREG_FW_VERSION_H 0x02
+#define VREG_FW_VERSION_L 0x03
+#define VREG_CONFIG       0x04
+#define VREG_INTEGRATION  0x05
+#define VREG_DEVICE_TEMP  0x06
+#define VREG_LED_CONFIG   0x07
+#define VREG_RAW_START    0x08  // 6 canales x 2 bytes (alto, bajo)
+#define VREG_CAL_START    0x14  // 6 canales x float de 4 bytes (big-endian)
+#define VREG_DEV_SEL      0x4F
+
+// LED_CONFIG: con el driver habilitado (bit 3) los canales del dispositivo
+// suben en proporción a la corriente (bits 5:4)
+#define LED_DRV_ENABLE 0x08
+#define LED_SIGNAL     200
+
+// Lecturas de STATUS que devuelven TX_VALID tras cada escritura, para que el
+// driver recorra también la espera del protocolo real
+#define BUSY_POLLS 1
+
+#define MAX_FRAMES 1024
+#define NUM_DEVICES 3
+#define NUM_INSTANCES 8   // Un cabezal por canal del multiplexor
+#define INSTANCE_OFFSET 5 // Desfase en tramas del CSV entre cabezales
+
+static uint16_t frames[MAX_FRAMES][NUM_DEVICES * 6];
+static int num_frames = 0;
+
+// Estado de cada AS7265x simulado
+typedef struct {
+    int frame_idx;
+    uint8_t dev_sel;
+    uint8_t config_reg;
+    uint8_t integration_reg;
+    uint8_t led_config[NUM_DEVICES];
+    int busy;
+    bool rx_valid;
+    uint8_t read_value;
+    int pending_write;  // Registro virtual pendiente de recibir su valor
+    bool stuck;         // Avería inyectada: TX_VALID fijo hasta recuperar el bus
+} sim_sensor_t;
+
+static sim_sensor_t sensors[NUM_INSTANCES];
+static bool sensors_ready = false;
+static uint8_t mux_channels[2];  // Byte de control del multiplexor de cada puerto
+
+static void init_sensors(void) {
+    for (int i = 0; i < NUM_INSTANCES; i++) {
+        sensors[i] = (sim_sensor_t){
+            .frame_idx = i * INSTANCE_OFFSET - 1,
+            .config_reg = 0x28,
+            .integration_reg = 0x3B,
+            .pending_write = -1,
+        };
+    }
+    sensors_ready = true;
+}
+
+// Instancia que responde en la dirección del AS7265x: la del puerto 1, o la
+// del primer canal habilitado en el multiplexor del puerto 0
+static sim_sensor_t *selected_sensor(uint8_t port) {
+    int instance = port;
+    for (int ch = 0; ch < NUM_INSTANCES; ch++) {
+        if (mux_channels[port & 1] & (1 << ch)) {
+            instance = (port + ch) % NUM_INSTANCES;
+            break;
+        }
+    }
+    if (!sensors_ready) {
+        init_sensors();
+    }
+    return &sensors[instance];
+}
+
+void as7265x_sim_mux_select(uint8_t port, uint8_t channels) {
+    mux_channels[port & 1] = channels;
+}
+
+void as7265x_sim_inject_stuck(uint8_t port) {
+    selected_sensor(port)->stuck = true;
+}
+
+// Los pulsos de SCL liberan el sensor, que descarta la transacción a medias
+void as7265x_sim_bus_recover(uint8_t port) {
+    for (int i = 0; i < NUM_INSTANCES; i++) {
+        sim_sensor_t *s = &sensors[i];
+        if (s->stuck) {
+            s->stuck = false;
+            s->busy = 0;
+            s->pending_write = -1;
+        }
+    }
+}
+
+// Espectro sintético por si no hay CSV: una campana distinta en cada trama
+static void generate_frames(void) {
+    num_frames = 64;
+    for (int f = 0; f < num_frames; f++) {
+        for (int ch = 0; ch < NUM_DEVICES * 6; ch++) {
+            int d = ch - (f % 18);
+            frames[f][ch] = 100 + 400 / (1 + d * d);
+        }
+    }
+}
+
+// Carga las tramas de un CSV de datos_materiales (con path NULL, o si no se
+// puede abrir, genera un espectro sintético). Devuelve el número de tramas.
+int as7265x_sim_load_csv(const char *path) {
+    FILE *f = path ? fopen(path, "r") : NULL;
+    char line[256];
+
+    num_frames = 0;
+    if (f == NULL) {
+        if (path != NULL) {
+            ESP_LOGW(TAG, "No se pudo abrir %s", path);
+        }
+        ESP_LOGI(TAG, "Usando espectro sintético");
+        generate_frames();
+        return num_frames;
+    }
+
+    fgets(line, sizeof(line), f);  // Cabecera
+    while (num_frames < MAX_FRAMES && fgets(line, sizeof(line), f)) {
+        char *p = strchr(line, ',');  // Saltar el timestamp
+        int ch = 0;
+        while (p != NULL && ch < NUM_DEVICES * 6) {
+            frames[num_frames][ch++] = (uint16_t)strtoul(p + 1, NULL, 10);
+            p = strchr(p + 1, ',');
+        }
+        if (ch == NUM_DEVICES * 6) {
+            num_frames++;
+        }
+    }
+    fclose(f);
+
+    if (num_frames == 0) {
+        generate_frames();
+    }
+    ESP_LOGI(TAG, "%d tramas cargadas de %s", num_frames, path);
+    return num_frames;
+}
+
+static const uint16_t *current_frame(const sim_sensor_t *s) {
+    return frames[s->frame_idx < 0 || num_frames == 0 ? 0 : s->frame_idx % num_frames];
+}
+
+static uint8_t virtual_read(sim_sensor_t *s, uint8_t vreg) {
+    const uint16_t *frame = current_frame(s);
+    uint8_t dev_sel = s->dev_sel;
+
+    if (vreg >= VREG_RAW_START && vreg < VREG_RAW_START + 12) {
+        uint16_t value = frame[dev_sel * 6 + (vreg - VREG_RAW_START) / 2];
+        if (s->led_config[dev_sel] & LED_DRV_ENABLE) {
+            value += LED_SIGNAL << ((s->led_config[dev_sel] >> 4) & 0x03);
+        }
+        return (vreg - VREG_RAW_START) % 2 == 0 ? value >> 8 : value & 0xFF;
+    }
+    if (vreg >= VREG_CAL_START && vreg < VREG_CAL_START + 24) {
+        float cal = frame[dev_sel * 6 + (vreg - VREG_CAL_START) / 4] * 1.0f;
+        uint32_t bits;
+        memcpy(&bits, &cal, sizeof(bits));
+        return bits >> (8 * (3 - (vreg - VREG_CAL_START) % 4));
+    }
+
+    switch (vreg) {
+        case VREG_HW_VERSION_H: return 0x40;
+        case VREG_HW_VERSION_L: return 0x41;
+        case VREG_FW_VERSION_H: return 0x00;
+        case VREG_FW_VERSION_L: return 0x0C;
+        case VREG_CONFIG:       return s->config_reg;
+        case VREG_INTEGRATION:  return s->integration_reg;
+        case VREG_DEVICE_TEMP:  return 28 + dev_sel;
+        case VREG_LED_CONFIG:   return s->led_config[dev_sel];
+        case VREG_DEV_SEL:      return dev_sel;
+        default:                return 0;
+    }
+}
+
+static void virtual_write(sim_sensor_t *s, uint8_t vreg, uint8_t value) {
+    switch (vreg) {
+        case VREG_DEV_SEL: {
+            // Volver a un dispositivo igual o anterior marca el comienzo de una
+            // trama nueva (con máscara de canales no siempre se selecciona el primero)
+            uint8_t previous = s->dev_sel;
+            s->dev_sel = value % NUM_DEVICES;
+            if (s->dev_sel <= previous && num_frames > 0) {
+                s->frame_idx = (s->frame_idx + 1) % num_frames;
+            }
+            break;
+        }
+        case VREG_CONFIG:      s->config_reg = value; break;
+        case VREG_INTEGRATION: s->integration_reg = value; break;
+        case VREG_LED_CONFIG:  s->led_config[s->dev_sel] = value; break;
+        default: break;
+    }
+}
+
+esp_err_t as7265x_sim_read(uint8_t port, uint8_t reg, uint8_t *data) {
+    sim_sensor_t *s = selected_sensor(port);
+
+    switch (reg) {
+        case SLAVE_STATUS_REG:
+            *data = (s->rx_valid ? STATUS_RX_VALID : 0) | (s->busy > 0 || s->stuck ? STATUS_TX_VALID : 0);
+            if (s->busy > 0) {
+                s->busy--;
+            }
+            return ESP_OK;
+        case SLAVE_READ_REG:
+            *data = s->read_value;
+            s->rx_valid = false;
+            return ESP_OK;
+        default:
+            *data = 0;
+            return ESP_OK;
+    }
+}
+
+esp_err_t as7265x_sim_write(uint8_t port, uint8_t reg, uint8_t data) {
+    sim_sensor_t *s = selected_sensor(port);
+
+    if (reg != SLAVE_WRITE_REG) {
+        return ESP_OK;
+    }
+
+    if (s->pending_write >= 0) {
+        virtual_write(s, s->pending_write, data);
+        s->pending_write = -1;
+    } else if (data & 0x80) {
+        s->pending_write = data & 0x7F;  // Dirección con bit de escritura: el valor llega después
+    } else {
+        s->read_value = virtual_read(s, data);
+        s->rx_valid = true;
+    }
+    s->busy = BUSY_POLLS;
+    return ESP_OK;
+}
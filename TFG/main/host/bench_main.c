@@ -0,0 +1,352 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include "esp_timer.h"
+#include "as7265x.h"
+#include "oled.h"
+#include "sample_ring.h"
+#include "thingsboard_control.h"
+#include "metrics.h"
+#include "trace.h"
+#include "dlog.h"
+#include "sim.h"
+#include "classifier.h"
+#include "spectral.h"
+
+// Banco de pruebas del pipeline adquisición -> serialización -> publicación
+// para el target linux:
+//   idf.py -B build-linux -D IDF_TARGET=linux -D SDKCONFIG=build-linux/sdkconfig build
+//   ./build-linux/app-template.elf
+// Variables de entorno:
+//   AS7265X_SIM_CSV   CSV de datos_materiales que reproduce el sensor simulado
+//   BENCH_FRAMES      número de tramas a procesar (100 por defecto)
+//   BENCH_METRICS=1   vuelca también /metrics en formato Prometheus al terminar
+//   BENCH_TRACE=1     vuelca el anillo de trazas (CONFIG_TRACE_ENABLED) para
+//                     tools/trace_to_chrome.py
+//   BENCH_LOG=1       vuelca el anillo del log diferido para tools/dlog_decode.py
+//   BENCH_MASK        máscara de canales adicional a medir (p. ej. la que
+//                     exporta app.py), en hexadecimal
+
+#ifndef SIM_DEFAULT_CSV
+#define SIM_DEFAULT_CSV "espectroscopia_Papel Azul.csv"
+#endif
+
+static esp_err_t stdout_sink(void *ctx, const char *data, size_t len) {
+    fwrite(data, 1, len, stdout);
+    return ESP_OK;
+}
+
+static void print_stage(const char *name, metric_hist_t hist) {
+    uint32_t count;
+    uint64_t sum_us;
+
+    metrics_get_hist(hist, &count, &sum_us);
+    if (count == 0) {
+        printf("%-22s %10s\n", name, "-");
+        return;
+    }
+    double mean_us = (double)sum_us / count;
+    printf("%-22s %8" PRIu32 " %12.1f %14.1f\n", name, count, mean_us, 1e6 / mean_us);
+}
+
+// Coste de bus de una lectura de trama: operaciones I2C y su tiempo por trama,
+// cruda o con los valores calibrados de fábrica
+static void bench_readout(const char *name, int frames, bool calibrated) {
+    static float values[SAMPLE_CHANNELS];
+    uint32_t count_before, count_after;
+    uint64_t sum_before, sum_after;
+    sample_frame_t frame;
+
+    metrics_get_hist(METRIC_HIST_I2C_AS7265X, &count_before, &sum_before);
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < frames; i++) {
+        as7265x_read_frame_calibrated(as7265x_get_head(0), &frame, calibrated ? values : NULL);
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start;
+    metrics_get_hist(METRIC_HIST_I2C_AS7265X, &count_after, &sum_after);
+
+    printf("%-22s %10.1f %14.1f %12.1f\n", name, (double)(count_after - count_before) / frames,
+           (double)(sum_after - sum_before) / frames, (double)elapsed_us / frames);
+}
+
+// Tramas/s con cada máscara de canales frente a leer los 18
+static void bench_masks(int frames, uint32_t extra_mask) {
+    static const struct {
+        const char *name;
+        uint32_t mask;
+    } masks[] = {
+        { "18 canales", AS7265X_ALL_CHANNELS },
+        { "RSTUVW GHIJKL", AS7265X_DEVICE_CHANNELS(0) | AS7265X_DEVICE_CHANNELS(1) },
+        { "RSTUVW", AS7265X_DEVICE_CHANNELS(0) },
+        { "R G A", 0x01041 },
+        { "RST", 0x00007 },
+    };
+    as7265x_head_t *head = as7265x_get_head(0);
+    uint32_t saved_mask = head->channel_mask;
+    double full_us = 0;
+    int num_masks = sizeof(masks) / sizeof(masks[0]);
+
+    for (int m = 0; m <= num_masks; m++) {
+        const char *name = m < num_masks ? masks[m].name : "BENCH_MASK";
+        uint32_t mask = m < num_masks ? masks[m].mask : extra_mask;
+        uint32_t count_before, count_after;
+        uint64_t sum;
+        sample_frame_t frame;
+
+        if (m == num_masks && extra_mask == 0) {
+            break;
+        }
+        head->channel_mask = mask;
+        metrics_get_hist(METRIC_HIST_I2C_AS7265X, &count_before, &sum);
+        int64_t start = esp_timer_get_time();
+        for (int i = 0; i < frames; i++) {
+            as7265x_read_frame(head, &frame);
+        }
+        double us = (double)(esp_timer_get_time() - start) / frames;
+        metrics_get_hist(METRIC_HIST_I2C_AS7265X, &count_after, &sum);
+        if (m == 0) {
+            full_us = us;
+        }
+        printf("%-16s 0x%05" PRIx32 " %10.1f %12.1f %10.2f %8.2fx\n", name, mask,
+               (double)(count_after - count_before) / frames, us, 1e6 / us, full_us / us);
+    }
+    head->channel_mask = saved_mask;
+}
+
+// Peor latencia de trama con el bus bloqueado cada period tramas: la trama
+// afectada agota su plazo, se descarta y el cabezal se recupera
+static void bench_faults(int frames, int period) {
+    as7265x_head_t *head = as7265x_get_head(0);
+    uint32_t timeouts = metrics_get_counter(METRIC_VREG_TIMEOUTS);
+    uint32_t recoveries = metrics_get_counter(METRIC_BUS_RECOVERIES);
+    int64_t worst_ok_us = 0, worst_failed_us = 0;
+    int failed = 0;
+    sample_frame_t frame;
+
+    for (int i = 0; i < frames; i++) {
+        if (i % period == period / 2) {
+            as7265x_sim_inject_stuck(head->port);
+        }
+        int64_t start = esp_timer_get_time();
+        esp_err_t err = as7265x_read_frame(head, &frame);
+        if (err != ESP_OK) {
+            as7265x_recover(head);
+        }
+        int64_t elapsed_us = esp_timer_get_time() - start;
+        if (err != ESP_OK) {
+            failed++;
+            worst_failed_us = elapsed_us > worst_failed_us ? elapsed_us : worst_failed_us;
+        } else {
+            worst_ok_us = elapsed_us > worst_ok_us ? elapsed_us : worst_ok_us;
+        }
+    }
+
+    printf("%d tramas, %d descartadas, %" PRIu32 " plazos agotados, %" PRIu32 " recuperaciones\n", frames, failed,
+           metrics_get_counter(METRIC_VREG_TIMEOUTS) - timeouts, metrics_get_counter(METRIC_BUS_RECOVERIES) - recoveries);
+    // Cada intento puede pasarse de su plazo como mucho en el tick que estaba durmiendo
+    printf("peor trama correcta: %.1f ms, peor trama con averia (con recuperacion): %.1f ms\n",
+           worst_ok_us / 1000.0, worst_failed_us / 1000.0);
+    printf("cota de la lectura fallida: %.1f ms + recuperacion\n",
+           worst_ok_us / 1000.0 + (CONFIG_AS7265X_VREG_RETRIES + 1) * (CONFIG_AS7265X_VREG_TIMEOUT_MS + portTICK_PERIOD_MS));
+}
+
+// Ráfaga a RAM frente a publicar trama a trama: la captura solo espera al bus
+// y a Tint, y la subida va en mensajes de varias tramas
+static void bench_burst(int frames) {
+    static sample_frame_t burst[CONFIG_BURST_MAX_FRAMES];
+    as7265x_head_t *head = as7265x_get_head(0);
+    uint32_t messages_before, messages_after;
+    uint64_t bytes_before, bytes_after;
+    sample_frame_t frame;
+    int captured;
+
+    if (frames > CONFIG_BURST_MAX_FRAMES) {
+        frames = CONFIG_BURST_MAX_FRAMES;
+    }
+
+    mqtt_sim_get_stats(&messages_before, &bytes_before);
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < frames; i++) {
+        as7265x_read_frame(head, &frame);
+        send_data_to_thingsboard_mqtt(&frame, NULL, esp_timer_get_time());
+    }
+    int64_t single_us = esp_timer_get_time() - start;
+    mqtt_sim_get_stats(&messages_after, &bytes_after);
+    printf("%-14s %8d %12.1f %10s %10" PRIu32 " %10" PRIu64 "\n", "trama a trama", frames, single_us / 1000.0, "-",
+           messages_after - messages_before, bytes_after - bytes_before);
+
+    mqtt_sim_get_stats(&messages_before, &bytes_before);
+    start = esp_timer_get_time();
+    as7265x_capture_burst(head, burst, frames, &captured);
+    int64_t capture_us = esp_timer_get_time() - start;
+    send_burst_to_thingsboard_mqtt(burst, captured, 0);
+    int64_t upload_us = esp_timer_get_time() - start - capture_us;
+    mqtt_sim_get_stats(&messages_after, &bytes_after);
+    printf("%-14s %8d %12.1f %10.1f %10" PRIu32 " %10" PRIu64 "\n", "rafaga", captured, capture_us / 1000.0,
+           upload_us / 1000.0, messages_after - messages_before, bytes_after - bytes_before);
+    printf("rafaga: %.2f tramas/s (limite por Tint: %.2f tramas/s)\n", captured * 1e6 / capture_us,
+           1e6 / (head->integration_reg * 2800.0));
+}
+
+// Clasificación en la placa: bosque completo frente a la caché LRU, con las
+// tramas del CSV simulado (el mismo material delante del sensor)
+static void bench_classifier(int frames) {
+    static sample_frame_t captured[CONFIG_SAMPLE_RING_LEN];
+    as7265x_head_t *head = as7265x_get_head(0);
+    uint32_t hits = metrics_get_counter(METRIC_CLASSIFIER_CACHE_HITS);
+    int8_t label;
+    uint8_t confidence;
+
+    if (frames > CONFIG_SAMPLE_RING_LEN) {
+        frames = CONFIG_SAMPLE_RING_LEN;
+    }
+    for (int i = 0; i < frames; i++) {
+        as7265x_read_frame(head, &captured[i]);
+    }
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < frames; i++) {
+        classifier_run(&captured[i], &label, &confidence);
+    }
+    double forest_us = (double)(esp_timer_get_time() - start) / frames;
+
+    start = esp_timer_get_time();
+    for (int i = 0; i < frames; i++) {
+        classifier_classify(&captured[i]);
+    }
+    double cached_us = (double)(esp_timer_get_time() - start) / frames;
+    hits = metrics_get_counter(METRIC_CLASSIFIER_CACHE_HITS) - hits;
+
+    int novel = 0;
+    bool is_novel;
+    start = esp_timer_get_time();
+    for (int i = 0; i < frames; i++) {
+        classifier_novelty(&captured[i], captured[i].label, &is_novel);
+        novel += is_novel;
+    }
+    double novelty_us = (double)(esp_timer_get_time() - start) / frames;
+
+    printf("%-14s %12.2f %10s\n", "bosque", forest_us, "-");
+    printf("%-14s %12.2f %9.1f%%\n", "con cache", cached_us, 100.0 * hits / frames);
+    printf("%-14s %12.2f %7d nov\n", "novedad", novelty_us, novel);
+    printf("ultima trama: %s (%.0f%%, distancia %.1f)\n", classifier_label_name(captured[frames - 1].label),
+           100.0 * captured[frames - 1].confidence / 255, captured[frames - 1].distance / 16.0);
+}
+
+// Etapa de características: el coste por trama (en el ESP32, los ciclos los
+// mide bench_qemu.c) y el resultado de la última trama
+static void bench_features(int frames) {
+    static sample_frame_t captured[CONFIG_SAMPLE_RING_LEN];
+    as7265x_head_t *head = as7265x_get_head(0);
+    int num_ratios;
+    const spectral_ratio_t *ratios = spectral_telemetry_ratios(&num_ratios);
+    spectral_features_t features;
+
+    if (frames > CONFIG_SAMPLE_RING_LEN) {
+        frames = CONFIG_SAMPLE_RING_LEN;
+    }
+    for (int i = 0; i < frames; i++) {
+        as7265x_read_frame(head, &captured[i]);
+    }
+
+    // Cada trama muchas veces: una sola dura menos que la resolución de esp_timer
+    int64_t start = esp_timer_get_time();
+    for (int r = 0; r < 1000; r++) {
+        for (int i = 0; i < frames; i++) {
+            spectral_compute(captured[i].values, ratios, num_ratios, &features);
+        }
+    }
+    double ns = (esp_timer_get_time() - start) * 1e3 / (1000.0 * frames);
+
+    printf("%-14s %12.1f\n", "todas", ns);
+    printf("ultima trama:");
+    for (int i = 0; i < num_ratios; i++) {
+        printf(" %c/%c=%.3f", spectral_channel_name(ratios[i].num), spectral_channel_name(ratios[i].den),
+               features.ratios[i] / 256.0);
+    }
+    printf(" %c_a=%.4f %c_v=%.4f %c_d=%.4f\n", spectral_channel_name(spectral_band_channel(0)),
+           features.area[0] / 16384.0, spectral_channel_name(spectral_band_channel(0)), features.vector[0] / 16384.0,
+           spectral_channel_name(spectral_band_channel(0)), features.derivative[0] / 16384.0);
+}
+
+void app_main(void) {
+    const char *csv = getenv("AS7265X_SIM_CSV");
+    const char *frames_env = getenv("BENCH_FRAMES");
+    int num_frames = frames_env ? atoi(frames_env) : 100;
+
+    as7265x_sim_load_csv(csv ? csv : SIM_DEFAULT_CSV);
+
+    gpio_init();
+    as7265x_init();
+    spectral_init();
+    as7265x_head_init(as7265x_get_head(0));
+    sample_ring_init();
+    oled_init();
+    mqtt_app_start();
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < num_frames; i++) {
+        sample_frame_t frame;
+        int64_t acquired_us = esp_timer_get_time();
+        as7265x_read_frame(as7265x_get_head(0), &frame);
+        sample_ring_push(&frame);
+        send_data_to_thingsboard_mqtt(&frame, NULL, acquired_us);
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start;
+
+    uint32_t messages;
+    uint64_t bytes;
+    mqtt_sim_get_stats(&messages, &bytes);
+
+    printf("\n==== Banco de pruebas del pipeline (%d tramas) ====\n", num_frames);
+    printf("%-22s %8s %12s %14s\n", "etapa", "n", "media (us)", "max (ops/s)");
+    print_stage("i2c as7265x", METRIC_HIST_I2C_AS7265X);
+    print_stage("adquisicion trama", METRIC_HIST_FRAME_ACQ);
+    print_stage("serializacion", METRIC_HIST_SERIALIZE);
+    print_stage("publicacion", METRIC_HIST_PUBLISH);
+    print_stage("adquisicion a PUBACK", METRIC_HIST_PUBACK);
+    printf("total: %.2f tramas/s, %" PRIu32 " mensajes, %" PRIu64 " bytes publicados\n",
+           num_frames * 1e6 / elapsed_us, messages, bytes);
+
+    printf("\n==== Lectura cruda frente a calibrada (%d tramas) ====\n", num_frames);
+    printf("%-22s %10s %14s %12s\n", "lectura", "i2c/trama", "i2c us/trama", "us/trama");
+    bench_readout("cruda", num_frames, false);
+    bench_readout("cruda + calibrada", num_frames, true);
+
+    const char *mask_env = getenv("BENCH_MASK");
+    printf("\n==== Mascaras de canales (%d tramas) ====\n", num_frames);
+    printf("%-16s %7s %10s %12s %10s %9s\n", "canales", "mascara", "i2c/trama", "us/trama", "tramas/s", "ganancia");
+    bench_masks(num_frames, mask_env ? (uint32_t)strtoul(mask_env, NULL, 16) : 0);
+
+    printf("\n==== Rafaga a RAM frente a trama a trama (%d tramas) ====\n", num_frames);
+    printf("%-14s %8s %12s %10s %10s %10s\n", "modo", "tramas", "captura (ms)", "subida (ms)", "mensajes", "bytes");
+    bench_burst(num_frames);
+
+    printf("\n==== Clasificador en la placa (%d tramas, %d bits de clave) ====\n", num_frames,
+           CONFIG_CLASSIFIER_CACHE_BITS);
+    printf("%-14s %12s %10s\n", "modo", "us/trama", "aciertos");
+    bench_classifier(num_frames);
+
+    printf("\n==== Caracteristicas espectrales (%d tramas) ====\n", num_frames);
+    printf("%-14s %12s\n", "grupo", "ns/trama");
+    bench_features(num_frames);
+
+    printf("\n==== Bus bloqueado cada 10 tramas (%d tramas) ====\n", num_frames);
+    bench_faults(num_frames, 10);
+
+    const char *dump = getenv("BENCH_METRICS");
+    if (dump && dump[0] == '1') {
+        metrics_write_prometheus(stdout_sink, NULL);
+    }
+    const char *trace = getenv("BENCH_TRACE");
+    if (trace && trace[0] == '1') {
+        trace_dump_uart();
+    }
+    const char *log = getenv("BENCH_LOG");
+    if (log && log[0] == '1') {
+        dlog_dump_uart();
+    }
+    fflush(stdout);
+    exit(0);
+}
@@ -0,0 +1,27 @@
+#include <stddef.h>
+#include "sim.h"
+
+// Como dsps_mulc_s16_ansi de esp-dsp: (x * C) >> 15
+esp_err_t dsps_mulc_s16(const int16_t *input, int16_t *output, int len, int16_t C, int step_in, int step_out) {
+    if (input == NULL || output == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (int i = 0; i < len; i++) {
+        int32_t acc = (int32_t)input[i * step_in] * C;
+        output[i * step_out] = (int16_t)(acc >> 15);
+    }
+    return ESP_OK;
+}
+
+// Como dsps_sub_s16_ansi de esp-dsp: (a - b) >> shift
+esp_err_t dsps_sub_s16(const int16_t *input1, const int16_t *input2, int16_t *output, int len, int step1,
+                       int step2, int step_out, int shift) {
+    if (input1 == NULL || input2 == NULL || output == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (int i = 0; i < len; i++) {
+        int32_t acc = (int32_t)input1[i * step1] - input2[i * step2];
+        output[i * step_out] = (int16_t)(acc >> shift);
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "hal.h"
+#include "sim.h"
+
+#define AS7265X_ADDR 0x49
+#define SSD1306_ADDR 0x3C
+#define TCA9548A_ADDR_MIN 0x70
+#define TCA9548A_ADDR_MAX 0x77
+
+// ---------------------------------------------------------------------------
+// I2C: el AS7265x se simula; el multiplexor elige la instancia simulada; la
+// pantalla acepta todo; el resto no responde (NACK)
+
+esp_err_t hal_i2c_read_reg(uint8_t port, uint8_t addr, uint8_t reg, uint8_t *data) {
+    switch (addr) {
+        case AS7265X_ADDR:
+            return as7265x_sim_read(port, reg, data);
+        case SSD1306_ADDR:
+            *data = 0;
+            return ESP_OK;
+        default:
+            return ESP_FAIL;
+    }
+}
+
+esp_err_t hal_i2c_write(uint8_t port, uint8_t addr, uint8_t reg, const uint8_t *data, size_t len) {
+    if (addr >= TCA9548A_ADDR_MIN && addr <= TCA9548A_ADDR_MAX) {
+        as7265x_sim_mux_select(port, reg);
+        return ESP_OK;
+    }
+    switch (addr) {
+        case AS7265X_ADDR:
+            for (size_t i = 0; i < len; i++) {
+                as7265x_sim_write(port, reg, data[i]);
+            }
+            return ESP_OK;
+        case SSD1306_ADDR:
+            return ESP_OK;
+        default:
+            return ESP_FAIL;
+    }
+}
+
+esp_err_t hal_i2c_init(uint8_t port, int sda_io, int scl_io, uint32_t freq_hz) {
+    return ESP_OK;
+}
+
+esp_err_t hal_i2c_bus_recover(uint8_t port) {
+    as7265x_sim_bus_recover(port);
+    return ESP_OK;
+}
+
+esp_err_t hal_i2c_probe(uint8_t port, uint8_t addr, uint32_t timeout_ms) {
+    if (addr == AS7265X_ADDR || addr == SSD1306_ADDR || (addr >= TCA9548A_ADDR_MIN && addr <= TCA9548A_ADDR_MAX)) {
+        return ESP_OK;
+    }
+    return ESP_FAIL;
+}
+
+// ---------------------------------------------------------------------------
+// Disparo: sin GPIO, lo genera el banco de pruebas con hal_sim_trigger_fire
+
+static hal_trigger_cb_t trigger_cb = NULL;
+
+esp_err_t hal_trigger_init(int gpio, bool rising_edge, hal_trigger_cb_t cb) {
+    trigger_cb = cb;
+    return ESP_OK;
+}
+
+void hal_sim_trigger_fire(void) {
+    if (trigger_cb != NULL) {
+        trigger_cb(esp_timer_get_time());
+    }
+}
+
+// ---------------------------------------------------------------------------
+// LED
+
+void hal_led_init(void) {
+}
+
+void hal_led_set_level(uint32_t level) {
+}
+
+// ---------------------------------------------------------------------------
+// MQTT: broker en memoria que solo cuenta mensajes y bytes. Los mensajes QoS 1
+// se confirman al publicar el siguiente, como si el PUBACK llegara entre tramas.
+
+static uint32_t published_messages = 0;
+static uint64_t published_bytes = 0;
+static hal_mqtt_published_cb_t published_cb = NULL;
+static int unacked_msg_id = -1;
+
+void hal_mqtt_start(const char *uri, const char *username, hal_mqtt_connection_cb_t on_connection,
+                    hal_mqtt_data_cb_t on_data, hal_mqtt_published_cb_t on_published) {
+    published_cb = on_published;
+    on_connection(true);
+}
+
+int hal_mqtt_publish(const char *topic, const char *data, int len, int qos) {
+    if (unacked_msg_id >= 0) {
+        published_cb(unacked_msg_id);
+        unacked_msg_id = -1;
+    }
+    published_messages++;
+    if (qos > 0) {
+        unacked_msg_id = published_messages;
+    }
+    published_bytes += len > 0 ? (size_t)len : strlen(data);
+    return published_messages;
+}
+
+int hal_mqtt_subscribe(const char *topic, int qos) {
+    return 0;
+}
+
+int hal_mqtt_outbox_size(void) {
+    return 0;
+}
+
+void mqtt_sim_get_stats(uint32_t *messages, uint64_t *bytes) {
+    *messages = published_messages;
+    *bytes = published_bytes;
+}
+
+// ---------------------------------------------------------------------------
+// Hora: la del PC ya está en hora
+
+void hal_time_sync_start(void) {
+}
+
+bool hal_time_synced(void) {
+    return true;
+}
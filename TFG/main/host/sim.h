@@ -0,0 +1,35 @@
+#ifndef SIM_H
+#define SIM_H
+
+// Periféricos simulados para el target linux (banco de pruebas en el PC)
+
+#include <stdint.h>
+#include "esp_err.h"
+
+// AS7265x simulado: implementa el protocolo de registros virtuales
+// (STATUS/WRITE/READ con TX_VALID y RX_VALID) y reproduce tramas de un CSV
+// con el formato de datos_materiales (timestamp,R,S,T,...,F). Hay una
+// instancia por cabezal: la del puerto 1 o la del canal elegido en el
+// multiplexor, cada una desfasada en el CSV.
+int as7265x_sim_load_csv(const char *path);
+esp_err_t as7265x_sim_read(uint8_t port, uint8_t reg, uint8_t *data);
+esp_err_t as7265x_sim_write(uint8_t port, uint8_t reg, uint8_t data);
+void as7265x_sim_mux_select(uint8_t port, uint8_t channels);
+// Avería del bus para el banco de pruebas: el sensor seleccionado deja de
+// atender el protocolo (TX_VALID fijo) hasta hal_i2c_bus_recover
+void as7265x_sim_inject_stuck(uint8_t port);
+void as7265x_sim_bus_recover(uint8_t port);
+
+// Flanco en la entrada de disparo simulada
+void hal_sim_trigger_fire(void);
+
+// Estadísticas del broker MQTT en memoria
+void mqtt_sim_get_stats(uint32_t *messages, uint64_t *bytes);
+
+// esp-dsp no se compila para el target linux: versiones ANSI, con la misma
+// aritmética, de las rutinas que usa spectral.c
+esp_err_t dsps_mulc_s16(const int16_t *input, int16_t *output, int len, int16_t C, int step_in, int step_out);
+esp_err_t dsps_sub_s16(const int16_t *input1, const int16_t *input2, int16_t *output, int len, int step1,
+                       int step2, int step_out, int shift);
+
+#endif // SIM_H
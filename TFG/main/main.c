@@ -6,6 +6,18 @@
 #include "web_server.h"
 #include "as7265x.h"
 #include "oled.h"
+#include "sample_ring.h"
+#include "thingsboard_control.h"
+#include "boot.h"
+#include "trigger.h"
+#include "spectral.h"
+#include "hal.h"
+#if CONFIG_BENCH_QEMU
+#include "bench_qemu.h"
+#endif
+#if CONFIG_AS7265X_SIMULATED
+#include "sim.h"
+#endif
 
 #define I2C_MASTER_SCL_IO 22          // GPIO para SCL
 #define I2C_MASTER_SDA_IO 21          // GPIO para SDA
@@ -19,56 +31,63 @@ void app_main() {
         nvs_flash_erase();
         nvs_flash_init();
     }
+    boot_phase_done(BOOT_PHASE_NVS);
 
     //Inicialización de los componentes I2C
 
     gpio_init();
 
+#if CONFIG_AS7265X_SIMULATED
+    as7265x_sim_load_csv(NULL);  // Sin bus físico: sensor simulado con espectro sintético
+#else
     i2c_master_init();
+#endif
+    boot_phase_done(BOOT_PHASE_I2C);
 
     as7265x_init();
+    trigger_init();
+    spectral_init();
 
-    xTaskCreate(&sensor_task, "sensor_task", 4096, NULL, 5, NULL);
-
-    vTaskDelay(pdMS_TO_TICKS(2000));
-    
-    oled_init();
+    // Arranque en paralelo: cada cabezal se configura en su tarea de
+    // adquisición y la pantalla en la del HUD mientras aquí arranca la WiFi
+    sample_ring_init();
+    thingsboard_publisher_start();
+    for (int i = 0; i < as7265x_num_heads(); i++) {
+        xTaskCreate(&sensor_task, "sensor_task", 4096, as7265x_get_head(i), 5, NULL);
+    }
     xTaskCreate(oled_hud_task, "oled_hud_task", 2048, NULL, 5, NULL);
+#if CONFIG_BENCH_QEMU
+    bench_qemu_start();
+#else
     //Intenta conectar a Wi-Fi y si no, abre AP
 
     try_auto_connect();
+#endif
 }
 
-// Función para realizar un escaneo I2C
-void i2c_scanner() {
-    printf("Escaneando el bus I2C...\n");
-    for (int addr = 1; addr < 127; addr++) {
-        i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-        i2c_master_start(cmd);
-        i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_WRITE, true);
-        i2c_master_stop(cmd);
-        esp_err_t ret = i2c_master_cmd_begin(I2C_MASTER_NUM, cmd, pdMS_TO_TICKS(1000));
-        i2c_cmd_link_delete(cmd);
-
-        if (ret == ESP_OK) {
-            printf("Dispositivo encontrado en dirección: 0x%02X\n", addr);
-        }
-    }
-    printf("Escaneo finalizado.\n");
-}
+// Dispositivos que deben responder según la configuración de cabezales
+static const boot_i2c_dev_t expected_devices[] = {
+    { 0, 0x3C },  // SSD1306
+#if CONFIG_AS7265X_HEADS_MUX
+    { 0, CONFIG_AS7265X_MUX_ADDR },
+#else
+    { 0, 0x49 },  // AS7265x
+#endif
+#if CONFIG_AS7265X_HEADS_DUAL_PORT
+    { 1, 0x49 },
+#endif
+};
 
 void i2c_master_init() {
-    i2c_config_t conf = {
-        .mode = I2C_MODE_MASTER,
-        .sda_io_num = I2C_MASTER_SDA_IO,
-        .scl_io_num = I2C_MASTER_SCL_IO,
-        .sda_pullup_en = GPIO_PULLUP_ENABLE,
-        .scl_pullup_en = GPIO_PULLUP_ENABLE,
-        .master.clk_speed = I2C_MASTER_FREQ_HZ,
-    };
-    ESP_ERROR_CHECK(i2c_param_config(I2C_MASTER_NUM, &conf));
-    ESP_ERROR_CHECK(i2c_driver_install(I2C_MASTER_NUM, conf.mode, 0, 0, 0));
+    // La HAL guarda la configuración para reinstalar el driver si hay que recuperar el bus
+    ESP_ERROR_CHECK(hal_i2c_init(I2C_MASTER_NUM, I2C_MASTER_SDA_IO, I2C_MASTER_SCL_IO, I2C_MASTER_FREQ_HZ));
+
+#if CONFIG_AS7265X_HEADS_DUAL_PORT
+    // Segundo cabezal en su propio puerto: sus lecturas van en paralelo
+    ESP_ERROR_CHECK(hal_i2c_init(I2C_NUM_1, CONFIG_I2C1_SDA_IO, CONFIG_I2C1_SCL_IO, I2C_MASTER_FREQ_HZ));
+#endif
 
-    printf("Escaneando dispositivos I2C...\n");
-    i2c_scanner();
+    // Solo se sondean las direcciones conocidas (mapa en NVS); el bus completo
+    // únicamente si cambia el hardware
+    boot_probe_i2c(expected_devices, sizeof(expected_devices) / sizeof(expected_devices[0]));
 }
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_system.h"
+#if !CONFIG_IDF_TARGET_LINUX
+#include "esp_heap_caps.h"
+#endif
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sample_ring.h"
+#include "thingsboard_control.h"
+#include "metrics.h"
+#include "boot.h"
+
+// Límites superiores de los buckets en microsegundos (el último es +Inf)
+static const uint32_t bucket_bounds_us[] = {
+    50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000,
+    2500000, 5000000
+};
+#define NUM_BUCKETS (sizeof(bucket_bounds_us) / sizeof(bucket_bounds_us[0]) + 1)
+
+typedef struct {
+    uint32_t buckets[NUM_BUCKETS];
+    uint32_t count;
+    uint64_t sum_us;
+} hist_data_t;
+
+// Cada núcleo escribe solo en su copia y el scrape suma ambas. La escritura se
+// hace con las interrupciones del núcleo enmascaradas (unos pocos ciclos), sin
+// spinlocks ni contención entre núcleos en el camino crítico.
+typedef struct {
+    uint32_t counters[METRIC_COUNTER_COUNT];
+    hist_data_t hists[METRIC_HIST_COUNT];
+} metrics_core_t;
+
+static metrics_core_t per_core[portNUM_PROCESSORS];
+
+static const struct {
+    const char *name;
+    const char *help;
+    const char *labels;
+} hist_info[METRIC_HIST_COUNT] = {
+    [METRIC_HIST_I2C_AS7265X] = { "spectrometer_i2c_transaction_seconds", "Latencia de una transaccion I2C", "device=\"as7265x\"" },
+    [METRIC_HIST_I2C_SSD1306] = { "spectrometer_i2c_transaction_seconds", "Latencia de una transaccion I2C", "device=\"ssd1306\"" },
+    [METRIC_HIST_FRAME_ACQ]   = { "spectrometer_frame_acquisition_seconds", "Tiempo de adquisicion de una trama de 18 canales", "" },
+    [METRIC_HIST_SERIALIZE]   = { "spectrometer_serialize_seconds", "Tiempo de serializacion de la telemetria", "" },
+    [METRIC_HIST_PUBLISH]     = { "spectrometer_publish_seconds", "Tiempo de publicacion MQTT de la telemetria", "" },
+    [METRIC_HIST_PUBACK]      = { "spectrometer_acquisition_to_puback_seconds", "Latencia desde el inicio de la adquisicion hasta el PUBACK del broker", "" },
+    [METRIC_HIST_TRIGGER]     = { "spectrometer_trigger_to_first_frame_seconds", "Latencia desde el flanco de disparo hasta la primera trama de la rafaga", "" },
+    [METRIC_HIST_CLASSIFY]    = { "spectrometer_classify_seconds", "Tiempo de clasificacion de una trama en la placa", "" },
+};
+
+static const struct {
+    const char *name;
+    const char *help;
+} counter_info[METRIC_COUNTER_COUNT] = {
+    [METRIC_FRAMES_ACQUIRED]   = { "spectrometer_frames_acquired_total", "Tramas adquiridas" },
+    [METRIC_FRAMES_PUBLISHED]  = { "spectrometer_frames_published_total", "Tramas publicadas por MQTT" },
+    [METRIC_FRAMES_ACKED]      = { "spectrometer_frames_acked_total", "Tramas confirmadas por el broker (PUBACK)" },
+    [METRIC_PUBLISH_ERRORS]    = { "spectrometer_publish_errors_total", "Errores al publicar por MQTT" },
+    [METRIC_I2C_ERRORS]        = { "spectrometer_i2c_errors_total", "Transacciones I2C fallidas" },
+    [METRIC_WS_FRAMES_DROPPED] = { "spectrometer_ws_frames_dropped_total", "Tramas descartadas por clientes WebSocket lentos" },
+    [METRIC_VREG_TIMEOUTS]     = { "spectrometer_vreg_timeouts_total", "Esperas de STATUS del AS7265x que agotaron su plazo" },
+    [METRIC_BUS_RECOVERIES]    = { "spectrometer_i2c_bus_recoveries_total", "Recuperaciones del bus I2C y reconfiguraciones del sensor" },
+    [METRIC_TRIGGERS]          = { "spectrometer_triggers_total", "Flancos de disparo externo aceptados" },
+    [METRIC_TRIGGERS_MISSED]   = { "spectrometer_triggers_missed_total", "Disparos que llegaron antes de atender el anterior" },
+    [METRIC_TRIGGER_OVERRUNS]  = { "spectrometer_trigger_overruns_total", "Flancos descartados por llegar durante la ráfaga del anterior" },
+    [METRIC_FRAMES_DEADBAND]   = { "spectrometer_frames_deadband_total", "Tramas no publicadas por no salir de la banda muerta" },
+    [METRIC_CLASSIFIER_CACHE_HITS]   = { "spectrometer_classifier_cache_hits_total", "Tramas clasificadas con la caché, sin inferencia" },
+    [METRIC_CLASSIFIER_CACHE_MISSES] = { "spectrometer_classifier_cache_misses_total", "Tramas clasificadas recorriendo el bosque" },
+    [METRIC_NOVEL_FRAMES]      = { "spectrometer_novel_frames_total", "Tramas fuera de la distribución del material predicho" },
+    [METRIC_MQTT_FRAMES_DROPPED] = { "spectrometer_mqtt_frames_dropped_total", "Tramas que el anillo expulsó antes de publicarlas por MQTT" },
+};
+
+void metrics_count(metric_counter_t counter, uint32_t n) {
+    uint32_t irq = portSET_INTERRUPT_MASK_FROM_ISR();
+    per_core[xPortGetCoreID()].counters[counter] += n;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(irq);
+}
+
+void metrics_observe_us(metric_hist_t hist, uint32_t us) {
+    int bucket = 0;
+    while (bucket < NUM_BUCKETS - 1 && us > bucket_bounds_us[bucket]) {
+        bucket++;
+    }
+
+    uint32_t irq = portSET_INTERRUPT_MASK_FROM_ISR();
+    hist_data_t *h = &per_core[xPortGetCoreID()].hists[hist];
+    h->buckets[bucket]++;
+    h->count++;
+    h->sum_us += us;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(irq);
+}
+
+// Valor de un contador, sumando ambos núcleos
+uint32_t metrics_get_counter(metric_counter_t counter) {
+    uint32_t total = 0;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        total += per_core[core].counters[counter];
+    }
+    return total;
+}
+
+// Número de observaciones y suma (us) de un histograma, sumando ambos núcleos
+void metrics_get_hist(metric_hist_t hist, uint32_t *count, uint64_t *sum_us) {
+    *count = 0;
+    *sum_us = 0;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        *count += per_core[core].hists[hist].count;
+        *sum_us += per_core[core].hists[hist].sum_us;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Exposición en formato de texto de Prometheus
+
+#define CHUNK_SIZE 1024
+
+typedef struct {
+    metrics_sink_t sink;
+    void *ctx;
+    char buf[CHUNK_SIZE];
+    size_t used;
+    esp_err_t err;
+} metrics_writer_t;
+
+static void metrics_flush(metrics_writer_t *w) {
+    if (w->used > 0 && w->err == ESP_OK) {
+        w->err = w->sink(w->ctx, w->buf, w->used);
+    }
+    w->used = 0;
+}
+
+static void metrics_printf(metrics_writer_t *w, const char *fmt, ...) {
+    va_list args;
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        va_start(args, fmt);
+        int n = vsnprintf(w->buf + w->used, sizeof(w->buf) - w->used, fmt, args);
+        va_end(args);
+        if (n >= 0 && w->used + n < sizeof(w->buf)) {
+            w->used += n;
+            return;
+        }
+        metrics_flush(w);  // No cabía: se envía lo acumulado y se reintenta
+    }
+}
+
+static void write_header(metrics_writer_t *w, const char *name, const char *help, const char *type) {
+    metrics_printf(w, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+static void write_histograms(metrics_writer_t *w) {
+    for (int i = 0; i < METRIC_HIST_COUNT; i++) {
+        hist_data_t total = { 0 };
+        for (int core = 0; core < portNUM_PROCESSORS; core++) {
+            const hist_data_t *h = &per_core[core].hists[i];
+            for (int b = 0; b < NUM_BUCKETS; b++) {
+                total.buckets[b] += h->buckets[b];
+            }
+            total.count += h->count;
+            total.sum_us += h->sum_us;
+        }
+
+        if (i == 0 || strcmp(hist_info[i].name, hist_info[i - 1].name) != 0) {
+            write_header(w, hist_info[i].name, hist_info[i].help, "histogram");
+        }
+        const char *labels = hist_info[i].labels;
+        const char *sep = labels[0] ? "," : "";
+        uint32_t cumulative = 0;
+        for (int b = 0; b < NUM_BUCKETS - 1; b++) {
+            cumulative += total.buckets[b];
+            metrics_printf(w, "%s_bucket{%s%sle=\"%" PRIu32 ".%06" PRIu32 "\"} %" PRIu32 "\n",
+                           hist_info[i].name, labels, sep,
+                           bucket_bounds_us[b] / 1000000, bucket_bounds_us[b] % 1000000, cumulative);
+        }
+        cumulative += total.buckets[NUM_BUCKETS - 1];
+        metrics_printf(w, "%s_bucket{%s%sle=\"+Inf\"} %" PRIu32 "\n", hist_info[i].name, labels, sep, cumulative);
+        metrics_printf(w, "%s_sum{%s} %" PRIu64 ".%06" PRIu64 "\n", hist_info[i].name, labels,
+                       total.sum_us / 1000000, total.sum_us % 1000000);
+        metrics_printf(w, "%s_count{%s} %" PRIu32 "\n", hist_info[i].name, labels, total.count);
+    }
+}
+
+static void write_counters(metrics_writer_t *w) {
+    for (int i = 0; i < METRIC_COUNTER_COUNT; i++) {
+        uint32_t total = 0;
+        for (int core = 0; core < portNUM_PROCESSORS; core++) {
+            total += per_core[core].counters[i];
+        }
+        write_header(w, counter_info[i].name, counter_info[i].help, "counter");
+        metrics_printf(w, "%s %" PRIu32 "\n", counter_info[i].name, total);
+    }
+}
+
+static void write_gauges(metrics_writer_t *w) {
+    uint32_t fill, overwritten, held;
+    sample_ring_get_stats(&fill, &overwritten, &held);
+
+    write_header(w, "spectrometer_ring_fill_frames", "Tramas guardadas en el anillo de muestras", "gauge");
+    metrics_printf(w, "spectrometer_ring_fill_frames %" PRIu32 "\n", fill);
+    write_header(w, "spectrometer_ring_capacity_frames", "Capacidad del anillo de muestras", "gauge");
+    metrics_printf(w, "spectrometer_ring_capacity_frames %d\n", CONFIG_SAMPLE_RING_LEN);
+    write_header(w, "spectrometer_ring_overwritten_total", "Tramas expulsadas del anillo por otras nuevas", "counter");
+    metrics_printf(w, "spectrometer_ring_overwritten_total %" PRIu32 "\n", overwritten);
+    write_header(w, "spectrometer_ring_held_frames", "Tramas del anillo que están leyendo los suscriptores", "gauge");
+    metrics_printf(w, "spectrometer_ring_held_frames %" PRIu32 "\n", held);
+
+    uint32_t hits = metrics_get_counter(METRIC_CLASSIFIER_CACHE_HITS);
+    uint32_t lookups = hits + metrics_get_counter(METRIC_CLASSIFIER_CACHE_MISSES);
+    write_header(w, "spectrometer_classifier_cache_hit_ratio", "Fraccion de tramas clasificadas desde la cache", "gauge");
+    metrics_printf(w, "spectrometer_classifier_cache_hit_ratio %.3f\n", lookups ? (double)hits / lookups : 0.0);
+
+    write_header(w, "spectrometer_mqtt_outbox_bytes", "Bytes pendientes en el outbox MQTT", "gauge");
+    metrics_printf(w, "spectrometer_mqtt_outbox_bytes %d\n", thingsboard_outbox_size());
+
+    write_header(w, "spectrometer_boot_phase_seconds", "Tiempo desde el arranque hasta el final de la fase", "gauge");
+    for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+        int64_t us = boot_phase_us(i);
+        if (us >= 0) {
+            metrics_printf(w, "spectrometer_boot_phase_seconds{phase=\"%s\"} %" PRId64 ".%06" PRId64 "\n",
+                           boot_phase_name(i), us / 1000000, us % 1000000);
+        }
+    }
+
+#if !CONFIG_IDF_TARGET_LINUX
+    write_header(w, "spectrometer_heap_free_bytes", "Heap libre", "gauge");
+    metrics_printf(w, "spectrometer_heap_free_bytes %" PRIu32 "\n", esp_get_free_heap_size());
+    write_header(w, "spectrometer_heap_min_free_bytes", "Minimo historico de heap libre", "gauge");
+    metrics_printf(w, "spectrometer_heap_min_free_bytes %" PRIu32 "\n", esp_get_minimum_free_heap_size());
+    write_header(w, "spectrometer_heap_largest_free_block_bytes", "Mayor bloque libre del heap", "gauge");
+    metrics_printf(w, "spectrometer_heap_largest_free_block_bytes %u\n",
+                   (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+#endif
+}
+
+#if CONFIG_FREERTOS_USE_TRACE_FACILITY && CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+// Marca de agua de la pila y tiempo de CPU (us con esp_timer) de cada tarea
+static void write_tasks(metrics_writer_t *w) {
+    UBaseType_t num_tasks = uxTaskGetNumberOfTasks() + 2;  // Margen por si se crean tareas
+    TaskStatus_t *tasks = malloc(num_tasks * sizeof(TaskStatus_t));
+    uint32_t total_runtime;
+
+    if (tasks == NULL) {
+        return;
+    }
+    num_tasks = uxTaskGetSystemState(tasks, num_tasks, &total_runtime);
+
+    write_header(w, "spectrometer_task_stack_free_bytes", "Minimo de pila libre de la tarea", "gauge");
+    for (UBaseType_t i = 0; i < num_tasks; i++) {
+        metrics_printf(w, "spectrometer_task_stack_free_bytes{task=\"%s\"} %" PRIu32 "\n",
+                       tasks[i].pcTaskName, (uint32_t)tasks[i].usStackHighWaterMark);
+    }
+    write_header(w, "spectrometer_task_runtime_seconds_total", "Tiempo de CPU consumido por la tarea", "counter");
+    for (UBaseType_t i = 0; i < num_tasks; i++) {
+        metrics_printf(w, "spectrometer_task_runtime_seconds_total{task=\"%s\"} %" PRIu32 ".%06" PRIu32 "\n",
+                       tasks[i].pcTaskName, tasks[i].ulRunTimeCounter / 1000000, tasks[i].ulRunTimeCounter % 1000000);
+    }
+    free(tasks);
+}
+#endif
+
+// Escribe todas las métricas en formato de texto de Prometheus. La salida se
+// entrega a sink en bloques de CHUNK_SIZE bytes.
+esp_err_t metrics_write_prometheus(metrics_sink_t sink, void *ctx) {
+    static metrics_writer_t w;  // Un único lector a la vez (httpd o el banco de pruebas)
+
+    w.sink = sink;
+    w.ctx = ctx;
+    w.used = 0;
+    w.err = ESP_OK;
+
+    write_counters(&w);
+    write_histograms(&w);
+    write_gauges(&w);
+#if CONFIG_FREERTOS_USE_TRACE_FACILITY && CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    write_tasks(&w);
+#endif
+    metrics_flush(&w);
+    return w.err;
+}
@@ -0,0 +1,72 @@
+#include "esp_log.h"
+#include "esp_http_server.h"
+#include "metrics.h"
+#include "trace.h"
+#include "dlog.h"
+#include "metrics_http.h"
+
+static const char *TAG = "metrics";
+
+static esp_err_t send_chunk(void *ctx, const char *data, size_t len) {
+    return httpd_resp_send_chunk((httpd_req_t *)ctx, data, len);
+}
+
+// GET /metrics
+static esp_err_t metrics_handler(httpd_req_t *req) {
+    httpd_resp_set_type(req, "text/plain; version=0.0.4");
+
+    if (metrics_write_prometheus(send_chunk, req) != ESP_OK) {
+        ESP_LOGW(TAG, "Cliente desconectado durante /metrics");
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+// GET /trace.bin: anillo de trazas en binario (tools/trace_to_chrome.py)
+static esp_err_t trace_handler(httpd_req_t *req) {
+#if !CONFIG_TRACE_ENABLED
+    httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "Trazas desactivadas (CONFIG_TRACE_ENABLED)");
+    return ESP_OK;
+#else
+    httpd_resp_set_type(req, "application/octet-stream");
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"trace.bin\"");
+
+    if (trace_dump(send_chunk, req) != ESP_OK) {
+        ESP_LOGW(TAG, "Cliente desconectado durante /trace.bin");
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+#endif
+}
+
+// GET /log.bin: anillo del log diferido (tools/dlog_decode.py)
+static esp_err_t log_handler(httpd_req_t *req) {
+#if !CONFIG_DLOG_DEFERRED
+    httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "Log diferido desactivado (CONFIG_DLOG_DEFERRED)");
+    return ESP_OK;
+#else
+    httpd_resp_set_type(req, "application/octet-stream");
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"log.bin\"");
+
+    if (dlog_dump(send_chunk, req) != ESP_OK) {
+        ESP_LOGW(TAG, "Cliente desconectado durante /log.bin");
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+#endif
+}
+
+// Endpoints de diagnóstico: /metrics, /trace.bin y /log.bin
+esp_err_t metrics_register(httpd_handle_t server) {
+    httpd_uri_t uris[] = {
+        { .uri = "/metrics", .method = HTTP_GET, .handler = metrics_handler },
+        { .uri = "/trace.bin", .method = HTTP_GET, .handler = trace_handler },
+        { .uri = "/log.bin", .method = HTTP_GET, .handler = log_handler },
+    };
+    esp_err_t err = ESP_OK;
+
+    for (int i = 0; i < sizeof(uris) / sizeof(uris[0]) && err == ESP_OK; i++) {
+        err = httpd_register_uri_handler(server, &uris[i]);
+    }
+    return err;
+}
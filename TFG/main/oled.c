@@ -1,50 +1,42 @@
-#include "driver/i2c.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "esp_log.h"
+#include <stdio.h>
+#include <stdbool.h>
 #include <string.h>
-#include "esp_sntp.h"
+#include "hal.h"
+#include "oled.h"
+#include "metrics.h"
+#include "trace.h"
+#include "boot.h"
 
-#define I2C_MASTER_SCL_IO 22
-#define I2C_MASTER_SDA_IO 21
-#define I2C_MASTER_NUM I2C_NUM_0
-#define I2C_MASTER_FREQ_HZ 400000
 #define SSD1306_ADDR 0x3C  // Dirección I2C común para SSD1306
+#define OLED_I2C_PORT 0    // La pantalla va en I2C_NUM_0, delante del multiplexor
 #define SSD1306_COL_OFFSET 2
 
 // Enviar comandos al SSD1306
 static esp_err_t ssd1306_send_cmd(uint8_t cmd) {
-    i2c_cmd_handle_t handle = i2c_cmd_link_create();
-    esp_err_t err;
-
-    i2c_master_start(handle);
-    i2c_master_write_byte(handle, (SSD1306_ADDR << 1) | I2C_MASTER_WRITE, true);
+    int64_t start = esp_timer_get_time();
 
     // Control byte: Co=0, D/C#=0 indica comando
-    i2c_master_write_byte(handle, 0x00, true);
-
-    i2c_master_write_byte(handle, cmd, true);
-
-    i2c_master_stop(handle);
-    err = i2c_master_cmd_begin(I2C_MASTER_NUM, handle, pdMS_TO_TICKS(1000));
-    i2c_cmd_link_delete(handle);
+    esp_err_t err = hal_i2c_write(OLED_I2C_PORT, SSD1306_ADDR, 0x00, &cmd, 1);
+    if (err != ESP_OK) {
+        metrics_count(METRIC_I2C_ERRORS, 1);
+    }
+    metrics_observe_since(METRIC_HIST_I2C_SSD1306, start);
     return err;
 }
 
 // Enviar datos (por ejemplo, buffer de pantalla)
 static esp_err_t ssd1306_send_data(const uint8_t* data, size_t len) {
-    i2c_cmd_handle_t handle = i2c_cmd_link_create();
-    esp_err_t err;
-
-    i2c_master_start(handle);
-    i2c_master_write_byte(handle, (SSD1306_ADDR << 1) | I2C_MASTER_WRITE, true);
+    int64_t start = esp_timer_get_time();
 
     // Control byte: Co=0, D/C#=1 indica datos
-    i2c_master_write_byte(handle, 0x40, true);
-
-    i2c_master_write(handle, data, len, true);
-
-    i2c_master_stop(handle);
-    err = i2c_master_cmd_begin(I2C_MASTER_NUM, handle, pdMS_TO_TICKS(1000));
-    i2c_cmd_link_delete(handle);
+    esp_err_t err = hal_i2c_write(OLED_I2C_PORT, SSD1306_ADDR, 0x40, data, len);
+    if (err != ESP_OK) {
+        metrics_count(METRIC_I2C_ERRORS, 1);
+    }
+    metrics_observe_since(METRIC_HIST_I2C_SSD1306, start);
     return err;
 }
 
@@ -250,11 +242,13 @@ void ssd1306_draw_string(uint8_t x_start, uint8_t page, const char* str) {
 
 // Mostrar mensaje en líneas intermedias (páginas 1 a 6)
 void hud_display_message(const char* msg, uint8_t page) {
+    TRACE_BEGIN(TRACE_HUD_FLUSH, page);
     // Limpiar línea
     for (uint8_t x = 0; x < 16; x++) {
         ssd1306_draw_char(x * 8, page, ' ');
     }
     ssd1306_draw_string(0, page, msg);
+    TRACE_END(TRACE_HUD_FLUSH, page);
 }
 
 // Mostrar hora arriba izquierda (página 0, columna 0)
@@ -262,11 +256,13 @@ void hud_display_time(int hour, int minute, int second) {
     char buf[9];
     snprintf(buf, sizeof(buf), "%02d:%02d:%02d", hour, minute, second);
 
+    TRACE_BEGIN(TRACE_HUD_FLUSH, 0);
     // Limpia donde irá la hora (col 0 a 9)
     for (uint8_t x = 0; x < 16; x++) {
         ssd1306_draw_char(x, 0, ' ');
     }
     ssd1306_draw_string(0, 0, buf);
+    TRACE_END(TRACE_HUD_FLUSH, 0);
 }
 
 void hud_display_wifi(bool connected) {
@@ -282,6 +278,7 @@ void hud_display_wifi(bool connected) {
 
 // Mostrar estado del sensor en la última línea (página 7)
 void hud_display_sensor_status(bool sensor_ok) {
+    TRACE_BEGIN(TRACE_HUD_FLUSH, 6);
     // Limpiar línea completa (128 columnas / 8 pixels por char = 16 chars)
     for (uint8_t x = 0; x < 16; x++) {
         ssd1306_draw_char(x * 8, 6, ' ');
@@ -291,9 +288,13 @@ void hud_display_sensor_status(bool sensor_ok) {
     } else {
         ssd1306_draw_string(0, 6, "SENSOR ERROR");
     }
+    TRACE_END(TRACE_HUD_FLUSH, 6);
 }
 // Tarea que actualiza el HUD OLED cada segundo
+// La pantalla se inicializa aquí, en paralelo con los sensores y la WiFi
 void oled_hud_task(void *pvParameters) {
+    oled_init();
+    boot_phase_done(BOOT_PHASE_OLED);
     ssd1306_clear();
     ssd1306_draw_string(0,1,"----------------");
     while (1) {
@@ -0,0 +1,227 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sample_ring.h"
+
+#define SAMPLE_RING_LEN CONFIG_SAMPLE_RING_LEN
+#define SAMPLE_RING_SLOTS (SAMPLE_RING_LEN + SAMPLE_RING_MAX_HELD)
+#define MAX_LISTENERS 4
+
+// Bus de tramas: el escritor (sensor_task de cada cabezal) publica cada trama
+// una vez en un hueco del pool y los lectores (WebSocket, API HTTP...) la leen
+// en su sitio, cada uno con su propio cursor de secuencia. Un hueco cuenta una
+// referencia mientras está en el anillo y otra por cada lector que lo tiene;
+// al expulsar una trama que alguien sigue leyendo, el escritor toma otro hueco
+// libre (hay SAMPLE_RING_MAX_HELD de más), así que un lector lento nunca
+// bloquea la adquisición ni ve cambiar la trama que está leyendo.
+static sample_frame_t slots[SAMPLE_RING_SLOTS];
+static uint8_t refs[SAMPLE_RING_SLOTS];
+static uint16_t ring[SAMPLE_RING_LEN];  // Hueco de cada secuencia (seq % SAMPLE_RING_LEN)
+static int free_hint = 0;
+static uint32_t held = 0;         // Referencias de lectores
+static uint32_t next_seq = 0;
+static uint32_t count = 0;
+static uint32_t overwritten = 0;  // Tramas expulsadas antes de tiempo por otras nuevas
+// Las ráfagas a RAM entran con la hora de captura, después de tramas en vivo de
+// otros cabezales; disorder_seq es la última trama más antigua que su anterior
+static int64_t last_timestamp_ms = INT64_MIN;
+static uint32_t disorder_seq = 0;
+static bool disordered = false;
+static TaskHandle_t listeners[MAX_LISTENERS];
+static portMUX_TYPE ring_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void sample_ring_init(void) {
+    taskENTER_CRITICAL(&ring_lock);
+    next_seq = 0;
+    count = 0;
+    overwritten = 0;
+    held = 0;
+    free_hint = 0;
+    last_timestamp_ms = INT64_MIN;
+    disordered = false;
+    memset(refs, 0, sizeof(refs));
+    memset(listeners, 0, sizeof(listeners));
+    taskEXIT_CRITICAL(&ring_lock);
+}
+
+// Con ring_lock: un hueco sin referencias
+static int take_free_slot(void) {
+    for (int i = 0; i < SAMPLE_RING_SLOTS; i++) {
+        int slot = (free_hint + i) % SAMPLE_RING_SLOTS;
+        if (refs[slot] == 0) {
+            free_hint = (slot + 1) % SAMPLE_RING_SLOTS;
+            return slot;
+        }
+    }
+    return -1;
+}
+
+// Guarda una trama (expulsa la más antigua si está lleno) y despierta a los lectores
+uint32_t sample_ring_push(sample_frame_t *frame) {
+    taskENTER_CRITICAL(&ring_lock);
+    if (count == SAMPLE_RING_LEN) {
+        refs[ring[next_seq % SAMPLE_RING_LEN]]--;
+        count--;
+        overwritten++;
+    }
+    // Siempre hay uno libre mientras cada lector retenga una trama como mucho
+    int slot = take_free_slot();
+    if (slot >= 0) {
+        frame->seq = next_seq;
+        if (frame->timestamp_ms < last_timestamp_ms) {
+            disorder_seq = next_seq;
+            disordered = true;
+        }
+        last_timestamp_ms = frame->timestamp_ms;
+        slots[slot] = *frame;
+        refs[slot] = 1;
+        ring[next_seq % SAMPLE_RING_LEN] = slot;
+        next_seq++;
+        count++;
+    }
+    taskEXIT_CRITICAL(&ring_lock);
+
+    if (slot < 0) {
+        return UINT32_MAX;
+    }
+    for (int i = 0; i < MAX_LISTENERS; i++) {
+        if (listeners[i] != NULL) {
+            xTaskNotifyGive(listeners[i]);
+        }
+    }
+    return frame->seq;
+}
+
+// Trama con número de secuencia seq, de solo lectura y sin copiarla, o NULL si
+// ya no está en el anillo. Hay que devolverla con sample_ring_release.
+const sample_frame_t *sample_ring_acquire(uint32_t seq) {
+    const sample_frame_t *frame = NULL;
+
+    taskENTER_CRITICAL(&ring_lock);
+    if ((uint32_t)(next_seq - seq - 1) < count) {
+        int slot = ring[seq % SAMPLE_RING_LEN];
+        refs[slot]++;
+        held++;
+        frame = &slots[slot];
+    }
+    taskEXIT_CRITICAL(&ring_lock);
+    return frame;
+}
+
+void sample_ring_release(const sample_frame_t *frame) {
+    taskENTER_CRITICAL(&ring_lock);
+    refs[frame - slots]--;
+    held--;
+    taskEXIT_CRITICAL(&ring_lock);
+}
+
+// Empieza a seguir el bus desde la próxima trama; task (si no es NULL) recibe
+// una notificación por cada trama nueva
+bool sample_ring_subscribe(sample_ring_sub_t *sub, TaskHandle_t task) {
+    sub->cursor = sample_ring_next_seq();
+    sub->dropped = 0;
+    return task == NULL || sample_ring_add_listener(task);
+}
+
+// Siguiente trama del suscriptor o NULL si está al día. Si el anillo lo ha
+// adelantado, salta a la más antigua y cuenta las perdidas en sub->dropped.
+const sample_frame_t *sample_ring_next(sample_ring_sub_t *sub) {
+    while (sub->cursor != sample_ring_next_seq()) {
+        const sample_frame_t *frame = sample_ring_acquire(sub->cursor);
+        if (frame != NULL) {
+            sub->cursor++;
+            return frame;
+        }
+        uint32_t oldest = sample_ring_oldest_seq();
+        sub->dropped += oldest - sub->cursor;
+        sub->cursor = oldest;
+    }
+    return NULL;
+}
+
+// Secuencia que recibirá la próxima trama
+uint32_t sample_ring_next_seq(void) {
+    taskENTER_CRITICAL(&ring_lock);
+    uint32_t seq = next_seq;
+    taskEXIT_CRITICAL(&ring_lock);
+    return seq;
+}
+
+// Secuencia de la trama más antigua que sigue disponible
+uint32_t sample_ring_oldest_seq(void) {
+    taskENTER_CRITICAL(&ring_lock);
+    uint32_t seq = next_seq - count;
+    taskEXIT_CRITICAL(&ring_lock);
+    return seq;
+}
+
+// Secuencia de la primera trama con marca de tiempo posterior a timestamp_ms.
+// Búsqueda binaria mientras el anillo esté ordenado por tiempo; si queda dentro
+// alguna trama fuera de orden, recorrido desde la más antigua (y detrás de la
+// devuelta puede haber otras anteriores a timestamp_ms: el lector las filtra)
+uint32_t sample_ring_find_after(int64_t timestamp_ms) {
+    taskENTER_CRITICAL(&ring_lock);
+    uint32_t lo = next_seq - count;
+    uint32_t hi = next_seq;
+    if (disordered && next_seq - disorder_seq < count) {
+        while (lo != hi && slots[ring[lo % SAMPLE_RING_LEN]].timestamp_ms <= timestamp_ms) {
+            lo++;
+        }
+    } else {
+        while (lo != hi) {
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (slots[ring[mid % SAMPLE_RING_LEN]].timestamp_ms > timestamp_ms) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+    }
+    taskEXIT_CRITICAL(&ring_lock);
+    return lo;
+}
+
+// Nivel de llenado, tramas sobrescritas y tramas retenidas por lectores (para /metrics)
+void sample_ring_get_stats(uint32_t *fill, uint32_t *overwritten_out, uint32_t *held_out) {
+    taskENTER_CRITICAL(&ring_lock);
+    *fill = count;
+    *overwritten_out = overwritten;
+    *held_out = held;
+    taskEXIT_CRITICAL(&ring_lock);
+}
+
+// Registra una tarea que recibirá una notificación por cada trama nueva
+bool sample_ring_add_listener(TaskHandle_t task) {
+    bool added = false;
+
+    taskENTER_CRITICAL(&ring_lock);
+    for (int i = 0; i < MAX_LISTENERS; i++) {
+        if (listeners[i] == NULL) {
+            listeners[i] = task;
+            added = true;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL(&ring_lock);
+    return added;
+}
+
+static uint8_t *put_le(uint8_t *p, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        *p++ = (uint8_t)(v >> (8 * i));
+    }
+    return p;
+}
+
+// Serializa una trama en formato binario compacto (SAMPLE_FRAME_WIRE_SIZE bytes)
+size_t sample_frame_pack(const sample_frame_t *frame, uint8_t *out) {
+    uint8_t *p = out;
+    p = put_le(p, frame->seq, 4);
+    p = put_le(p, (uint64_t)frame->timestamp_ms, 8);
+    p = put_le(p, (uint16_t)frame->temperature, 2);
+    for (int i = 0; i < SAMPLE_CHANNELS; i++) {
+        p = put_le(p, frame->values[i], 2);
+    }
+    *p++ = frame->head;
+    return p - out;
+}
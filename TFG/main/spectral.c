@@ -0,0 +1,132 @@
+#include <string.h>
+#include "esp_log.h"
+#if CONFIG_IDF_TARGET_LINUX
+#include "sim.h"
+#else
+#include "esp_dsp.h"
+#endif
+#include "spectral.h"
+
+static const char *TAG = "spectral";
+
+static const char channel_names[] = "RSTUVWGHIJKLABCDEF";
+// Canal de cada banda, de 410 a 940 nm: A B C D E F G H R I S J T U V W K L
+static const uint8_t band_channels[SPECTRAL_BANDS] = {
+    12, 13, 14, 15, 16, 17, 6, 7, 0, 8, 1, 9, 2, 3, 4, 5, 10, 11,
+};
+
+static spectral_ratio_t telemetry_ratios[SPECTRAL_MAX_RATIOS];
+static int num_telemetry_ratios;
+
+static int channel_index(char name) {
+    const char *p = name ? strchr(channel_names, name) : NULL;
+    return p ? p - channel_names : -1;
+}
+
+void spectral_init(void) {
+    const char *p = CONFIG_SPECTRAL_RATIOS;
+
+    num_telemetry_ratios = 0;
+    while (*p) {
+        // "N/D" con letras de canal, separados por comas
+        int num = channel_index(p[0]);
+        int den = p[0] && p[1] == '/' ? channel_index(p[2]) : -1;
+        if (num < 0 || den < 0 || (p[3] != ',' && p[3] != '\0')) {
+            ESP_LOGE(TAG, "CONFIG_SPECTRAL_RATIOS no válido en \"%s\"", p);
+            return;
+        }
+        if (num_telemetry_ratios == SPECTRAL_MAX_RATIOS) {
+            ESP_LOGW(TAG, "Solo se publican los %d primeros cocientes", SPECTRAL_MAX_RATIOS);
+            return;
+        }
+        telemetry_ratios[num_telemetry_ratios++] = (spectral_ratio_t){ num, den };
+        p += p[3] ? 4 : 3;
+    }
+}
+
+uint32_t spectral_isqrt(uint64_t x) {
+    uint64_t root = 0, bit = 1ull << 62;
+
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+void spectral_compute(const uint16_t values[SPECTRAL_BANDS], const spectral_ratio_t *ratios, int num_ratios,
+                      spectral_features_t *out) {
+    int16_t bands[SPECTRAL_BANDS];
+    uint32_t max = 0, area = 0;
+    uint64_t squares = 0;
+
+    for (int i = 0; i < num_ratios; i++) {
+        uint32_t num = values[ratios[i].num], den = values[ratios[i].den];
+        uint32_t ratio = den ? (num << 8) / den : (num ? UINT16_MAX : 0);
+        out->ratios[i] = ratio > UINT16_MAX ? UINT16_MAX : ratio;
+    }
+    for (int i = 0; i < SPECTRAL_BANDS; i++) {
+        if (values[band_channels[i]] > max) {
+            max = values[band_channels[i]];
+        }
+    }
+    if (max == 0) {
+        memset(out->derivative, 0, sizeof(out->derivative));
+        memset(out->area, 0, sizeof(out->area));
+        memset(out->vector, 0, sizeof(out->vector));
+        return;
+    }
+
+    // Coma flotante por bloque: el máximo pasa a [16384, 32767] para que las
+    // rutinas s16 trabajen con toda la resolución (las normalizadas no
+    // dependen de la escala)
+    int shift = max > INT16_MAX ? -1 : __builtin_clz(max) - 17;
+    for (int i = 0; i < SPECTRAL_BANDS; i++) {
+        uint32_t v = values[band_channels[i]];
+        bands[i] = shift < 0 ? v >> 1 : v << shift;
+        area += bands[i];
+        squares += (int32_t)bands[i] * bands[i];
+    }
+
+    // x * C >> 15 con C = 2^29 / total da Q14; total >= máximo >= 16384, así
+    // que C solo se sale de int16 en el caso límite de un único canal
+    uint32_t c = (1u << 29) / area;
+    dsps_mulc_s16(bands, out->area, SPECTRAL_BANDS, c > INT16_MAX ? INT16_MAX : c, 1, 1);
+    c = (1u << 29) / spectral_isqrt(squares);
+    dsps_mulc_s16(bands, out->vector, SPECTRAL_BANDS, c > INT16_MAX ? INT16_MAX : c, 1, 1);
+    dsps_sub_s16(out->area + 1, out->area, out->derivative, SPECTRAL_BANDS - 1, 1, 1, 1, 0);
+}
+
+int32_t spectral_get(const spectral_features_t *features, int index) {
+    if (index < SPECTRAL_AREA) {
+        return features->derivative[index - SPECTRAL_DERIVATIVE];
+    }
+    if (index < SPECTRAL_VECTOR) {
+        return features->area[index - SPECTRAL_AREA];
+    }
+    if (index < SPECTRAL_RATIOS) {
+        return features->vector[index - SPECTRAL_VECTOR];
+    }
+    return features->ratios[index - SPECTRAL_RATIOS];
+}
+
+const spectral_ratio_t *spectral_telemetry_ratios(int *num_ratios) {
+    *num_ratios = num_telemetry_ratios;
+    return telemetry_ratios;
+}
+
+char spectral_channel_name(int channel) {
+    return channel_names[channel];
+}
+
+int spectral_band_channel(int band) {
+    return band_channels[band];
+}
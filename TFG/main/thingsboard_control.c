@@ -1,136 +1,751 @@
 #include <stdio.h>
+#include <stdarg.h>
 #include <string.h>
-#include "mqtt_client.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
 #include "cJSON.h"
-#include "driver/gpio.h"
+#include "hal.h"
 #include "oled.h"
-#define LED_GPIO GPIO_NUM_2  // LED conectado al pin G2
+#include "metrics.h"
+#include "trace.h"
+#include "dlog.h"
+#include "calibration.h"
+#include "as7265x.h"
+#include "drift.h"
+#include "boot.h"
+#include "burst.h"
+#include "acq_settings.h"
+#include "classifier.h"
+#include "spectral.h"
+#include "heap_guard.h"
+#include "thingsboard_control.h"
 
 #define TAG "MQTT_THINGSBOARD"
 
+#if CONFIG_BENCH_QEMU
+#define THINGSBOARD_HOST CONFIG_BENCH_BROKER_URI
+#else
 #define THINGSBOARD_HOST "mqtt://demo.thingsboard.io"
+#endif
 #define ACCESS_TOKEN     "LIJKVkaWPC5wQgn56OkM"
 
-esp_mqtt_client_handle_t mqtt_client = NULL;
+// Telemetría publicada con QoS 1 pendiente de PUBACK, para medir la latencia
+// desde la adquisición hasta el broker. Si se llena se pisa la entrada más
+// antigua (ese mensaje ya no se mide).
+#define PENDING_ACKS 16
 
-void send_data_to_thingsboard_mqtt(uint16_t values[18], int temperature) {
-    cJSON *root = cJSON_CreateObject();
-    char channels[] = "RSTUVWGHIJKLABCDEF";
+static struct {
+    int msg_id;
+    int frames;           // Tramas del mensaje (más de una con lotes)
+    int64_t acquired_us;  // La de la primera
+} pending_acks[PENDING_ACKS];
+static int pending_next = 0;
+static portMUX_TYPE pending_lock = portMUX_INITIALIZER_UNLOCKED;
 
+static void mqtt_published_cb(int msg_id) {
+    int64_t acquired_us = 0;
+    int frames = 0;
+
+    portENTER_CRITICAL(&pending_lock);
+    for (int i = 0; i < PENDING_ACKS; i++) {
+        if (pending_acks[i].msg_id == msg_id) {
+            acquired_us = pending_acks[i].acquired_us;
+            frames = pending_acks[i].frames;
+            pending_acks[i].msg_id = 0;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&pending_lock);
+
+    TRACE_INSTANT(TRACE_PUBACK, msg_id);
+    if (acquired_us != 0) {
+        boot_phase_done(BOOT_PHASE_FIRST_TELEMETRY);
+        metrics_observe_since(METRIC_HIST_PUBACK, acquired_us);
+        metrics_count(METRIC_FRAMES_ACKED, frames);
+    }
+}
+
+static void track_puback(int msg_id, int frames, int64_t acquired_us) {
+    portENTER_CRITICAL(&pending_lock);
+    pending_acks[pending_next].msg_id = msg_id;
+    pending_acks[pending_next].frames = frames;
+    pending_acks[pending_next].acquired_us = acquired_us;
+    pending_next = (pending_next + 1) % PENDING_ACKS;
+    portEXIT_CRITICAL(&pending_lock);
+}
+
+// Añade al JSON que se está construyendo en buf. Si no cabe deja *len en -1
+// y las siguientes llamadas ya no escriben: quien lo construye descarta el
+// mensaje en lugar de publicar un JSON cortado.
+static void json_append(char *buf, size_t size, int *len, const char *fmt, ...) {
+    va_list args;
+
+    if (*len < 0) {
+        return;
+    }
+    va_start(args, fmt);
+    int n = vsnprintf(buf + *len, size - *len, fmt, args);
+    va_end(args);
+    *len = n < 0 || n >= (int)(size - *len) ? -1 : *len + n;
+}
+
+#if CONFIG_SPECTRAL_TELEMETRY_RATIOS || CONFIG_SPECTRAL_TELEMETRY_DERIVATIVE || CONFIG_SPECTRAL_TELEMETRY_AREA || \
+    CONFIG_SPECTRAL_TELEMETRY_VECTOR
+#define SPECTRAL_TELEMETRY 1
+// Peor caso con todos los grupos: ",\"A_d\":-1.0000" o ",\"R/G\":255.996" por característica
+#define SPECTRAL_JSON_SIZE (SPECTRAL_LEN * 16)
+
+// Características espectrales de la trama, con los mismos nombres que las
+// columnas de Machine Learning/caracteristicas.py
+static void append_features_json(char *buf, size_t size, int *len, const sample_frame_t *frame) {
+    int num_ratios;
+    const spectral_ratio_t *ratios = spectral_telemetry_ratios(&num_ratios);
+    spectral_features_t features;
+
+    spectral_compute(frame->values, ratios, num_ratios, &features);
+#if CONFIG_SPECTRAL_TELEMETRY_RATIOS
+    for (int i = 0; i < num_ratios; i++) {
+        json_append(buf, size, len, ",\"%c/%c\":%.3f", spectral_channel_name(ratios[i].num),
+                    spectral_channel_name(ratios[i].den), features.ratios[i] / 256.0);
+    }
+#endif
+#if CONFIG_SPECTRAL_TELEMETRY_DERIVATIVE
+    for (int i = 0; i < SPECTRAL_BANDS - 1; i++) {
+        json_append(buf, size, len, ",\"%c_d\":%.4f", spectral_channel_name(spectral_band_channel(i)),
+                    features.derivative[i] / 16384.0);
+    }
+#endif
+#if CONFIG_SPECTRAL_TELEMETRY_AREA
+    for (int i = 0; i < SPECTRAL_BANDS; i++) {
+        json_append(buf, size, len, ",\"%c_a\":%.4f", spectral_channel_name(spectral_band_channel(i)),
+                    features.area[i] / 16384.0);
+    }
+#endif
+#if CONFIG_SPECTRAL_TELEMETRY_VECTOR
+    for (int i = 0; i < SPECTRAL_BANDS; i++) {
+        json_append(buf, size, len, ",\"%c_v\":%.4f", spectral_channel_name(spectral_band_channel(i)),
+                    features.vector[i] / 16384.0);
+    }
+#endif
+}
+#else
+#define SPECTRAL_JSON_SIZE 0
+#endif
+
+// JSON de telemetría en búferes estáticos (uno de la tarea de publicación y
+// otro de las ráfagas) y así la publicación de cada trama no reserva memoria
+// (antes, árbol cJSON + cadena)
+#define TELEMETRY_JSON_SIZE (960 + SPECTRAL_JSON_SIZE)
+
+// Devuelve la longitud, o -1 si no cabe en size
+static int format_telemetry_json(char *buf, size_t size, const sample_frame_t *frame, const float *calibrated) {
+    const uint16_t *values = frame->values;
+    static const char channels[] = "RSTUVWGHIJKLABCDEF";
+    uint16_t reflectance[18];
+    int len = 0;
+
+    json_append(buf, size, &len, "{");
     for (int i = 0; i < 18; i++) {
         if (values[i] > 0) {
-            cJSON_AddNumberToObject(root, (char[]){channels[i], '\0'}, values[i]);
+            json_append(buf, size, &len, "%s\"%c\":%u", len > 1 ? "," : "", channels[i], values[i]);
+        }
+    }
+
+    // Con referencias oscura y blanca: reflectancia por canal como "R_r" (x10000)
+    if (calibration_apply(frame->head, values, reflectance)) {
+        for (int i = 0; i < 18; i++) {
+            if (frame->channel_mask & (1u << i)) {
+                json_append(buf, size, &len, "%s\"%c_r\":%u", len > 1 ? "," : "", channels[i], reflectance[i]);
+            }
+        }
+    }
+
+#if AS7265X_NUM_HEADS > 1
+    json_append(buf, size, &len, ",\"head\":%u", frame->head);
+#endif
+    if (frame->trigger_id != 0) {
+        json_append(buf, size, &len, ",\"trigger\":%" PRIu32, frame->trigger_id);
+    }
+    if (frame->label >= 0) {
+        json_append(buf, size, &len, ",\"material\":\"%s\",\"confidence\":%.2f",
+                    classifier_label_name(frame->label), frame->confidence / 255.0);
+        if (frame->distance > 0) {
+            json_append(buf, size, &len, ",\"distance\":%.1f%s", frame->distance / 16.0,
+                        frame->novel ? ",\"novel\":true" : "");
+        }
+    }
+#if SPECTRAL_TELEMETRY
+    append_features_json(buf, size, &len, frame);
+#endif
+
+    // Valores calibrados de fábrica (CONFIG_AS7265X_CALIBRATED_READOUT) como "R_c"
+    if (calibrated != NULL) {
+        for (int i = 0; i < 18; i++) {
+            if (frame->channel_mask & (1u << i)) {
+                json_append(buf, size, &len, "%s\"%c_c\":%.4g", len > 1 ? "," : "", channels[i], calibrated[i]);
+            }
         }
     }
 
-    if (temperature > 0) {
-        cJSON_AddNumberToObject(root, "temperature", temperature);
+    // La temperatura siempre es válida (0 °C incluido): media y la de cada dispositivo
+    json_append(buf, size, &len, "%s\"temperature\":%d", len > 1 ? "," : "", frame->temperature);
+    for (int i = 0; i < SAMPLE_DEVICES; i++) {
+        if (frame->channel_mask & AS7265X_DEVICE_CHANNELS(i)) {
+            json_append(buf, size, &len, ",\"temperature_%d\":%d", i, frame->die_temperature[i]);
+        }
+    }
+
+    json_append(buf, size, &len, "}");
+    return len;
+}
+
+static char telemetry_json[TELEMETRY_JSON_SIZE];
+
+// Una trama sin "ts", con "burst" si burst_id no es 0. Devuelve la longitud,
+// o -1 si no cabe en size.
+static int format_frame_json(char *buf, size_t size, const sample_frame_t *frame, const float *calibrated,
+                             uint32_t burst_id) {
+    int len = format_telemetry_json(buf, size, frame, calibrated);
+
+    if (len > 0 && burst_id != 0) {
+        // Sin la '}' final, para añadir el número de ráfaga
+        len--;
+        json_append(buf, size, &len, ",\"burst\":%" PRIu32 "}", burst_id);
+    }
+    return len;
+}
+
+// Varias tramas en el formato por lotes de ThingsBoard, [{"ts":..,"values":{..}},..],
+// con "burst" si burst_id no es 0. calibrated: n x 18 valores o NULL; values:
+// búfer de TELEMETRY_JSON_SIZE para los valores de cada trama.
+// Devuelve la longitud, o -1 si no caben.
+static int format_batch_json(char *buf, size_t size, char *values, const sample_frame_t *frames,
+                             const float *calibrated, int n, uint32_t burst_id) {
+    int len = 0;
+
+    json_append(buf, size, &len, "[");
+    for (int i = 0; i < n && len >= 0; i++) {
+        if (format_frame_json(values, TELEMETRY_JSON_SIZE, &frames[i],
+                              calibrated ? calibrated + i * SAMPLE_CHANNELS : NULL, burst_id) < 0) {
+            return -1;
+        }
+        json_append(buf, size, &len, "%s{\"ts\":%" PRId64 ",\"values\":%s}", i ? "," : "", frames[i].timestamp_ms,
+                    values);
     }
+    json_append(buf, size, &len, "]");
+    return len;
+}
 
-    char *json_data = cJSON_PrintUnformatted(root);
-    int msg_id = esp_mqtt_client_publish(mqtt_client, "v1/devices/me/telemetry", json_data, 0, 1, 0);
+// acquired_us: comienzo de la adquisición de la primera trama, o 0 si no se mide hasta el PUBACK
+static int publish_telemetry(const char *json, int len, int frames, int64_t acquired_us) {
+    int64_t start = esp_timer_get_time();
+    TRACE_BEGIN(TRACE_PUBLISH, 0);
+    int msg_id = hal_mqtt_publish("v1/devices/me/telemetry", json, len, 1);
+    metrics_observe_since(METRIC_HIST_PUBLISH, start);
+    TRACE_END(TRACE_PUBLISH, msg_id);
     if (msg_id >= 0){
-        ESP_LOGI(TAG, "Telemetry sent: %s", json_data);
+        metrics_count(METRIC_FRAMES_PUBLISHED, frames);
+        if (msg_id > 0 && acquired_us != 0) {
+            track_puback(msg_id, frames, acquired_us);
+        }
+        DLOG(DLOG_LEVEL_INFO, DLOG_TELEMETRY_SENT, msg_id, len);
+    } else {
+        metrics_count(METRIC_PUBLISH_ERRORS, 1);
+        DLOG(DLOG_LEVEL_WARN, DLOG_PUBLISH_FAILED, msg_id);
+    }
+    return msg_id;
+}
+
+// Antes de 2020 el reloj no está en hora: son segundos desde el arranque
+#define WALL_TIME_MIN_MS 1577836800000LL
+
+// "ts" solo si SNTP ya había puesto la hora cuando se adquirieron todas; si
+// no, ThingsBoard las archivaría en enero de 1970
+static bool frames_have_wall_time(const sample_frame_t *frames, int n) {
+    if (!hal_time_synced()) {
+        return false;
+    }
+    for (int i = 0; i < n; i++) {
+        if (frames[i].timestamp_ms < WALL_TIME_MIN_MS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Publica n tramas en mensajes por lotes de hasta per_message con "ts" o, sin
+// hora de SNTP, de una en una sin "ts" (ThingsBoard les pone la hora de
+// llegada). measure_puback: medir hasta el PUBACK desde la adquisición de la
+// primera trama de cada mensaje. Devuelve los bytes publicados, o -1 si un
+// mensaje no cabe en size o falla; *messages: mensajes publicados.
+static int publish_frames(char *buf, size_t size, char *values, const sample_frame_t *frames,
+                          const float *calibrated, int n, int per_message, uint32_t burst_id, bool measure_puback,
+                          int *messages) {
+    bool timed = frames_have_wall_time(frames, n);
+    int bytes = 0;
+
+    *messages = 0;
+    if (!timed) {
+        per_message = 1;
+    }
+    for (int first = 0; first < n; first += per_message) {
+        int count = n - first < per_message ? n - first : per_message;
+        const float *first_calibrated = calibrated ? calibrated + first * SAMPLE_CHANNELS : NULL;
+        int64_t start = esp_timer_get_time();
+        TRACE_BEGIN(TRACE_SERIALIZE, 0);
+        int len = timed ? format_batch_json(buf, size, values, frames + first, first_calibrated, count, burst_id)
+                        : format_frame_json(buf, size, &frames[first], first_calibrated, burst_id);
+        metrics_observe_since(METRIC_HIST_SERIALIZE, start);
+        TRACE_END(TRACE_SERIALIZE, 0);
+
+        if (len < 0) {
+            ESP_LOGE(TAG, "Las tramas %d-%d de %d no caben en un mensaje", first, first + count - 1, n);
+            metrics_count(METRIC_PUBLISH_ERRORS, 1);
+            return -1;
+        }
+        if (publish_telemetry(buf, len, count, measure_puback ? frames[first].acquired_us : 0) < 0) {
+            return -1;
+        }
+        (*messages)++;
+        bytes += len;
+    }
+    return bytes;
+}
+
+// Un mensaje con ACQ_MAX_BATCH tramas con valores calibrados de fábrica
+#define BATCH_FRAME_JSON_SIZE (TELEMETRY_JSON_SIZE + 48)
+
+// Tramas de cada cabezal esperando a completar un lote (parámetro batch)
+typedef struct {
+    sample_frame_t frames[ACQ_MAX_BATCH];
+    float calibrated[ACQ_MAX_BATCH][SAMPLE_CHANNELS];
+    bool has_calibrated;
+    int count;
+} telemetry_batch_t;
+
+static telemetry_batch_t batches[AS7265X_NUM_HEADS];
+// Solo serializa publisher_task, así que el JSON de los lotes es uno para todos los cabezales
+static char batch_json[ACQ_MAX_BATCH * BATCH_FRAME_JSON_SIZE];
+
+// Un lote a medias sale como mucho period_ms * batch después de su primera
+// trama (y nunca antes de este mínimo, con period_ms 0)
+#define BATCH_MIN_AGE_MS 1000
+
+static void flush_batch(telemetry_batch_t *batch) {
+    int messages;
+
+    publish_frames(batch_json, sizeof(batch_json), telemetry_json, batch->frames,
+                   batch->has_calibrated ? batch->calibrated[0] : NULL, batch->count, batch->count, 0, true, &messages);
+    batch->count = 0;
+}
+
+// Publica los lotes a medias que han agotado su plazo: con disparo externo y
+// menos tramas por disparo que batch, o con la adquisición parada, no llegaría
+// la trama que los completa. Devuelve los ticks hasta el siguiente plazo, o
+// portMAX_DELAY si no queda ningún lote a medias.
+static TickType_t flush_stale_batches(void) {
+    acq_settings_t settings;
+    TickType_t wait = portMAX_DELAY;
+
+    acq_settings_get(&settings);
+    uint32_t period_ms = settings.period_ms > BATCH_MIN_AGE_MS ? settings.period_ms : BATCH_MIN_AGE_MS;
+    int64_t max_age_us = (int64_t)period_ms * (settings.batch > 1 ? settings.batch : 1) * 1000;
+    for (int i = 0; i < AS7265X_NUM_HEADS; i++) {
+        telemetry_batch_t *batch = &batches[i];
+        if (batch->count == 0) {
+            continue;
+        }
+        int64_t left_us = batch->frames[0].acquired_us + max_age_us - esp_timer_get_time();
+        if (left_us <= 0) {
+            flush_batch(batch);
+        } else if (pdMS_TO_TICKS(left_us / 1000) + 1 < wait) {
+            wait = pdMS_TO_TICKS(left_us / 1000) + 1;
+        }
+    }
+    return wait;
+}
+
+// Última trama publicada de cada cabezal, para la banda muerta
+static uint16_t last_published[AS7265X_NUM_HEADS][SAMPLE_CHANNELS];
+static bool has_published[AS7265X_NUM_HEADS];
+
+// Algún canal leído se ha movido más de deadband cuentas desde la última publicada
+static bool outside_deadband(const sample_frame_t *frame, uint16_t deadband) {
+    const uint16_t *last = last_published[frame->head];
+
+    if (!has_published[frame->head]) {
+        return true;
+    }
+    for (int i = 0; i < SAMPLE_CHANNELS; i++) {
+        if ((frame->channel_mask & (1u << i)) && abs(frame->values[i] - last[i]) > deadband) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// calibrated: 18 valores calibrados de fábrica o NULL
+// acquired_us: esp_timer_get_time() al comenzar la adquisición de la trama
+void send_data_to_thingsboard_mqtt(const sample_frame_t *frame, const float *calibrated, int64_t acquired_us) {
+    acq_settings_t settings;
+    int json_len;
+
+    acq_settings_get(&settings);
+    // Una trama nueva (fuera de la distribución) sale siempre y sin esperar al lote
+    if (settings.deadband > 0 && !frame->novel && !outside_deadband(frame, settings.deadband)) {
+        metrics_count(METRIC_FRAMES_DEADBAND, 1);
+        return;
+    }
+    memcpy(last_published[frame->head], frame->values, sizeof(frame->values));
+    has_published[frame->head] = true;
+
+    // Una a una, como siempre, salvo que haya lote (o quede uno a medias al bajar batch a 1)
+    telemetry_batch_t *batch = &batches[frame->head];
+    if (settings.batch <= 1 && batch->count == 0) {
+        char *json_data = telemetry_json;
+        int64_t start = esp_timer_get_time();
+        TRACE_BEGIN(TRACE_SERIALIZE, 0);
+        json_len = format_telemetry_json(json_data, TELEMETRY_JSON_SIZE, frame, calibrated);
+        metrics_observe_since(METRIC_HIST_SERIALIZE, start);
+        TRACE_END(TRACE_SERIALIZE, 0);
+        if (json_len < 0) {
+            ESP_LOGE(TAG, "La trama no cabe en el JSON de telemetría; se descarta");
+            metrics_count(METRIC_PUBLISH_ERRORS, 1);
+            return;
+        }
+        publish_telemetry(json_data, json_len, 1, acquired_us);
+        return;
+    }
+
+    if (batch->count == 0) {
+        batch->has_calibrated = calibrated != NULL;
+    }
+    batch->frames[batch->count] = *frame;
+    if (calibrated != NULL) {
+        memcpy(batch->calibrated[batch->count], calibrated, sizeof(batch->calibrated[0]));
+    }
+    if (++batch->count < settings.batch && !frame->novel) {
+        return;
+    }
+
+    flush_batch(batch);
+}
+
+// Tarea suscrita al bus de tramas que publica cada trama nueva leyéndola en su
+// hueco del anillo, sin copiarla (las de las ráfagas las sube run_burst). Si
+// se retrasa tanto que el anillo la adelanta, las tramas perdidas se cuentan.
+static sample_ring_sub_t publisher_sub;
+
+static void publisher_task(void *pvParameter) {
+    sample_ring_sub_t *sub = &publisher_sub;
+    const sample_frame_t *frame;
+    uint32_t dropped = 0;
+    TickType_t wait = portMAX_DELAY;
+#if CONFIG_HEAP_GUARD
+    int warmup_frames = CONFIG_HEAP_GUARD_WARMUP_FRAMES;
+#endif
+
+    while (1) {
+        // Despierta con cada trama nueva o al vencer el plazo de un lote a medias
+        ulTaskNotifyTake(pdTRUE, wait);
+
+        while ((frame = sample_ring_next(sub)) != NULL) {
+            if (frame->burst_id == 0) {
+#if CONFIG_AS7265X_CALIBRATED_READOUT
+                send_data_to_thingsboard_mqtt(frame, frame->calibrated, frame->acquired_us);
+#else
+                send_data_to_thingsboard_mqtt(frame, NULL, frame->acquired_us);
+#endif
+#if CONFIG_HEAP_GUARD
+                // Como en sensor_task: pasado el calentamiento, publicar no debe reservar memoria
+                if (warmup_frames > 0 && --warmup_frames == 0) {
+                    heap_guard_arm();
+                }
+#endif
+            }
+            sample_ring_release(frame);
+        }
+        if (sub->dropped != dropped) {
+            ESP_LOGW(TAG, "%" PRIu32 " tramas expulsadas del anillo antes de publicarlas", sub->dropped - dropped);
+            metrics_count(METRIC_MQTT_FRAMES_DROPPED, sub->dropped - dropped);
+            dropped = sub->dropped;
+        }
+        wait = flush_stale_batches();
+    }
+}
+
+// Arranca la publicación de las tramas del anillo. Se suscribe aquí, antes de
+// crear los sensor_task, para no perder la primera trama.
+void thingsboard_publisher_start(void) {
+    TaskHandle_t task;
+
+    xTaskCreate(publisher_task, "publisher_task", 4096, NULL, 4, &task);
+    sample_ring_subscribe(&publisher_sub, task);
+}
+
+// Peor caso de una trama dentro del mensaje de una ráfaga (sin valores calibrados de fábrica)
+#define BURST_FRAME_JSON_SIZE (640 + SPECTRAL_JSON_SIZE)
+// Tramas por mensaje al subir una ráfaga: el búfer es estático y de tamaño
+// fijo, sea cual sea CONFIG_BURST_MAX_FRAMES
+#define BURST_CHUNK_FRAMES 8
+
+// Solo hay una ráfaga a la vez (burst.c), así que basta un búfer. La sube el
+// sensor_task del cabezal, en paralelo con la tarea de publicación.
+static char burst_json[BURST_CHUNK_FRAMES * BURST_FRAME_JSON_SIZE + 2];
+static char burst_values[TELEMETRY_JSON_SIZE];
+
+bool send_burst_to_thingsboard_mqtt(const sample_frame_t *frames, int n, uint32_t burst_id) {
+    int messages;
+
+    // Varios mensajes acotados con el mismo "burst"; ThingsBoard los junta por ts
+    int bytes = publish_frames(burst_json, sizeof(burst_json), burst_values, frames, NULL, n, BURST_CHUNK_FRAMES,
+                               burst_id, false, &messages);
+    if (bytes < 0) {
+        ESP_LOGE(TAG, "Ráfaga %" PRIu32 ": subida interrumpida tras %d mensajes", burst_id, messages);
+        return false;
+    }
+    ESP_LOGI(TAG, "Ráfaga %" PRIu32 ": %d tramas en %d mensajes (%d bytes)", burst_id, n, messages, bytes);
+    return true;
+}
+
+// Parámetros de adquisición aplicados, como atributos de cliente
+void thingsboard_report_settings(const acq_settings_t *settings) {
+    char json[128];
+    int len = snprintf(json, sizeof(json),
+                       "{\"period_ms\":%" PRIu32 ",\"gain\":%u,\"tint\":%u,\"batch\":%u,\"deadband\":%u}",
+                       settings->period_ms, settings->gain, settings->tint, settings->batch, settings->deadband);
+    int msg_id = hal_mqtt_publish("v1/devices/me/attributes", json, len, 1);
+    ESP_LOGI(TAG, "Parámetros de adquisición publicados: %s (msg_id %d)", json, msg_id);
+}
+
+// Bytes pendientes de envío en el outbox del cliente MQTT
+int thingsboard_outbox_size() {
+    return hal_mqtt_outbox_size();
+}
+
+// Copia terminada en '\0' de un campo del mensaje, truncada al tamaño del búfer
+static void copy_field(char *dst, size_t size, const char *src, int len) {
+    if (len >= (int)size) {
+        ESP_LOGW(TAG, "Campo MQTT de %d bytes truncado a %u", len, (unsigned)(size - 1));
+        len = size - 1;
+    }
+    memcpy(dst, src, len);
+    dst[len] = '\0';
+}
+
+// Respuesta a un RPC en v1/devices/me/rpc/response/<request_id>
+static void publish_rpc_response(const char *request_topic, bool success) {
+    // Obtener el ID de la solicitud del topic: v1/devices/me/rpc/request/<request_id>
+    const char *request_id = strrchr(request_topic, '/');  // Apunta a "/<request_id>"
+    if (request_id == NULL) {
+        return;
+    }
+    request_id++;  // Salta el '/'
+
+    char response_topic[100];
+    snprintf(response_topic, sizeof(response_topic), "v1/devices/me/rpc/response/%s", request_id);
+
+    // Publicar la respuesta
+    int ret = hal_mqtt_publish(response_topic, success ? "{\"success\":true}" : "{\"success\":false}", 0, 1);
+    ESP_LOGI(TAG, "Respuesta RPC publicada. Topic: %s, resultado: %d", response_topic, ret);
+}
+
+// Cabezal al que va dirigido un RPC: {"head": H} en params, 0 si no se indica
+static int rpc_head(const cJSON *params) {
+    const cJSON *head = cJSON_IsObject(params) ? cJSON_GetObjectItem(params, "head") : NULL;
+    return cJSON_IsNumber(head) ? head->valueint : 0;
+}
+
+// Campo numérico opcional entre 0 y max: false si está y no es válido
+static bool optional_field(const cJSON *obj, const char *key, uint32_t max, uint32_t *value) {
+    const cJSON *item = cJSON_GetObjectItem(obj, key);
+
+    if (item == NULL) {
+        return true;
     }
+    if (!cJSON_IsNumber(item) || item->valuedouble < 0 || item->valuedouble > max) {
+        return false;
+    }
+    *value = (uint32_t)item->valuedouble;
+    return true;
+}
 
-    cJSON_Delete(root);
-    free(json_data);
+// Campos presentes de period_ms, gain, tint, batch y deadband sobre los
+// parámetros pedidos ahora (del RPC setAcquisition o atributos compartidos)
+static esp_err_t request_settings(const cJSON *obj) {
+    acq_settings_t settings;
+
+    if (!cJSON_IsObject(obj)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    acq_settings_get(&settings);
+    uint32_t period_ms = settings.period_ms, gain = settings.gain, tint = settings.tint;
+    uint32_t batch = settings.batch, deadband = settings.deadband;
+    if (!optional_field(obj, "period_ms", UINT32_MAX, &period_ms) || !optional_field(obj, "gain", 3, &gain) ||
+        !optional_field(obj, "tint", UINT8_MAX, &tint) || !optional_field(obj, "batch", ACQ_MAX_BATCH, &batch) ||
+        !optional_field(obj, "deadband", UINT16_MAX, &deadband)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    settings.period_ms = period_ms;
+    settings.gain = gain;
+    settings.tint = tint;
+    settings.batch = batch;
+    settings.deadband = deadband;
+    return acq_settings_request(&settings);
 }
 
-// Callback para mensajes entrantes (como RPC)
-static void mqtt_event_handler_cb(esp_mqtt_event_handle_t event) {
-    switch (event->event_id) {
-        case MQTT_EVENT_DATA: {
-            char topic[event->topic_len + 1];
-            char data[event->data_len + 1];
+// Callback para mensajes entrantes (como RPC). Se llama siempre desde la
+// tarea de esp-mqtt, así que los búferes pueden ser estáticos.
+static void mqtt_event_handler_cb(const char *event_topic, int topic_len, const char *event_data, int data_len) {
+    static char topic[128];
+    static char data[512];
+
+    copy_field(topic, sizeof(topic), event_topic, topic_len);
+    copy_field(data, sizeof(data), event_data, data_len);
+
+    ESP_LOGI(TAG, "Incoming message: topic=%s, data=%s", topic, data);
 
-            memcpy(topic, event->topic, event->topic_len);
-            topic[event->topic_len] = '\0';
+    if (strncmp(topic, "v1/devices/me/attributes", 24) == 0) {
+        // Atributos compartidos: {"clave": valor} al cambiar alguno y
+        // {"shared": {...}} en la respuesta a la petición al conectar
+        cJSON *json = cJSON_Parse(data);
+        cJSON *shared = cJSON_GetObjectItem(json, "shared");
+        esp_err_t err = request_settings(shared ? shared : json);
+        if (err == ESP_ERR_INVALID_ARG) {
+            ESP_LOGW(TAG, "Atributos compartidos fuera de rango: %s", data);
+        }
+        cJSON_Delete(json);
 
-            memcpy(data, event->data, event->data_len);
-            data[event->data_len] = '\0';
+    } else if (strstr(topic, "rpc/request")) {
+        // Procesar el comando RPC
+        cJSON *json = cJSON_Parse(data);
+        cJSON *method = cJSON_GetObjectItem(json, "method");
+        cJSON *params = cJSON_GetObjectItem(json, "params");
 
-            ESP_LOGI(TAG, "Incoming message: topic=%s, data=%s", topic, data);
+        if (cJSON_IsString(method) && strcmp(method->valuestring, "setLed") == 0) {
+            bool led_state = false;
 
-            if (strstr(topic, "rpc/request")) {
-                // Procesar el comando RPC
-                cJSON *json = cJSON_Parse(data);
-                cJSON *method = cJSON_GetObjectItem(json, "method");
-                cJSON *params = cJSON_GetObjectItem(json, "params");
+            if (cJSON_IsBool(params)) {
+                led_state = cJSON_IsTrue(params);
+            } else if (cJSON_IsObject(params)) {
+                cJSON *state = cJSON_GetObjectItem(params, "state");
+                if (cJSON_IsBool(state)) {
+                    led_state = cJSON_IsTrue(state);
+                }
+            }
 
-                if (cJSON_IsString(method) && strcmp(method->valuestring, "setLed") == 0) {
-                    bool led_state = false;
+            ESP_LOGI(TAG, "LED command received: %s", led_state ? "ON" : "OFF");
 
-                    if (cJSON_IsBool(params)) {
-                        led_state = cJSON_IsTrue(params);
-                    } else if (cJSON_IsObject(params)) {
-                        cJSON *state = cJSON_GetObjectItem(params, "state");
-                        if (cJSON_IsBool(state)) {
-                            led_state = cJSON_IsTrue(state);
-                        }
-                    }
+            // Aquí puedes encender/apagar el LED físicamente
+            hal_led_set_level(!led_state);
+            publish_rpc_response(topic, true);
 
-                    ESP_LOGI(TAG, "LED command received: %s", led_state ? "ON" : "OFF");
+        } else if (cJSON_IsString(method) && (strcmp(method->valuestring, "calibrateDark") == 0 ||
+                                              strcmp(method->valuestring, "calibrateWhite") == 0)) {
+            // params: número de tramas, {"frames": N, "head": H} o nada (valor de Kconfig, cabezal 0)
+            cal_ref_kind_t kind = strcmp(method->valuestring, "calibrateDark") == 0 ? CAL_REF_DARK : CAL_REF_WHITE;
+            cJSON *frames = cJSON_IsObject(params) ? cJSON_GetObjectItem(params, "frames") : params;
+            int n = cJSON_IsNumber(frames) ? frames->valueint : 0;
 
-                    // Aquí puedes encender/apagar el LED físicamente
-                    gpio_set_level(LED_GPIO, !led_state);
+            publish_rpc_response(topic, calibration_request(rpc_head(params), kind, n) == ESP_OK);
 
-                    // Obtener el ID de la solicitud del topic: v1/devices/me/rpc/request/<request_id>
-                    char *request_id = strrchr(topic, '/');  // Apunta a "/<request_id>"
-                    if (request_id != NULL) {
-                        request_id++;  // Salta el '/'
-                        char response_topic[100];
-                        snprintf(response_topic, sizeof(response_topic), "v1/devices/me/rpc/response/%s", request_id);
+        } else if (cJSON_IsString(method) && strcmp(method->valuestring, "clearCalibration") == 0) {
+            publish_rpc_response(topic, calibration_clear(rpc_head(params)) == ESP_OK);
 
-                        // Publicar la respuesta
-                        int ret = esp_mqtt_client_publish(mqtt_client, response_topic, "{\"success\":true}", 0, 1, 0);
-                        ESP_LOGI(TAG, "Respuesta RPC publicada. Topic: %s, resultado: %d", response_topic, ret);
-                    }
+        } else if (cJSON_IsString(method) && strcmp(method->valuestring, "setIllumination") == 0) {
+            // params: {"interleaved": bool, "white": 0..4, "ir": 0..4, "uv": 0..4}, campos opcionales
+            static const char *const leds[AS7265X_NUM_DEVICES] = { "white", "ir", "uv" };
+            as7265x_illum_t illum;
+            bool ok = cJSON_IsObject(params);
 
+            as7265x_get_illumination(&illum);
+            if (ok && cJSON_IsBool(cJSON_GetObjectItem(params, "interleaved"))) {
+                illum.interleaved = cJSON_IsTrue(cJSON_GetObjectItem(params, "interleaved"));
+            }
+            for (int i = 0; ok && i < AS7265X_NUM_DEVICES; i++) {
+                cJSON *current = cJSON_GetObjectItem(params, leds[i]);
+                if (current == NULL) {
+                    continue;
+                }
+                ok = cJSON_IsNumber(current) && current->valueint >= AS7265X_LED_OFF &&
+                     current->valueint <= AS7265X_LED_100MA;
+                if (ok) {
+                    illum.current[i] = current->valueint;
                 }
+            }
+            if (ok) {
+                as7265x_set_illumination(&illum);
+            }
+            publish_rpc_response(topic, ok);
+
+        } else if (cJSON_IsString(method) && strcmp(method->valuestring, "setDriftCompensation") == 0) {
+            // params: {"tref": °C, "k": [18 coeficientes en ppm/°C, orden RSTUVW GHIJKL ABCDEF]}
+            cJSON *tref = cJSON_IsObject(params) ? cJSON_GetObjectItem(params, "tref") : NULL;
+            cJSON *k = cJSON_IsObject(params) ? cJSON_GetObjectItem(params, "k") : NULL;
+            int32_t k_ppm[SAMPLE_CHANNELS];
+            bool ok = cJSON_IsArray(k) && cJSON_GetArraySize(k) == SAMPLE_CHANNELS;
 
-                cJSON_Delete(json);
+            for (int i = 0; ok && i < SAMPLE_CHANNELS; i++) {
+                cJSON *item = cJSON_GetArrayItem(k, i);
+                ok = cJSON_IsNumber(item);
+                k_ppm[i] = ok ? item->valueint : 0;
             }
+            if (ok) {
+                ok = drift_set(cJSON_IsNumber(tref) ? tref->valueint : CONFIG_DRIFT_REF_TEMP, k_ppm) == ESP_OK;
+            }
+            publish_rpc_response(topic, ok);
 
-            break;
+        } else if (cJSON_IsString(method) && strcmp(method->valuestring, "setChannelMask") == 0) {
+            // params: {"mask": n} o n, bit i = canal i en orden RSTUVW GHIJKL ABCDEF
+            cJSON *mask = cJSON_IsObject(params) ? cJSON_GetObjectItem(params, "mask") : params;
+            // Fuera de rango se rechaza antes de convertirlo (como optional_field)
+            bool ok = cJSON_IsNumber(mask) && mask->valuedouble >= 0 && mask->valuedouble <= AS7265X_ALL_CHANNELS &&
+                      as7265x_set_channel_mask((uint32_t)mask->valuedouble) == ESP_OK;
+            publish_rpc_response(topic, ok);
+
+        } else if (cJSON_IsString(method) && strcmp(method->valuestring, "setAcquisition") == 0) {
+            // params: {"period_ms": ms, "gain": 0..3, "tint": 1..255, "batch": 1..8, "deadband": cuentas},
+            // campos opcionales; se aplican en la siguiente trama
+            publish_rpc_response(topic, request_settings(params) == ESP_OK);
+
+        } else if (cJSON_IsString(method) && strcmp(method->valuestring, "captureBurst") == 0) {
+            // params: {"frames": n, "head": h} o n; la respuesta solo confirma que se ha
+            // aceptado. Las tramas llegan después, todas con el mismo "burst", en mensajes
+            // de hasta BURST_CHUNK_FRAMES (o de una en una sin "ts" si no hay hora de SNTP)
+            cJSON *frames = cJSON_IsObject(params) ? cJSON_GetObjectItem(params, "frames") : params;
+            bool ok = cJSON_IsNumber(frames) && burst_request(rpc_head(params), frames->valueint) == ESP_OK;
+            publish_rpc_response(topic, ok);
         }
-        default:
-            break;
+
+        cJSON_Delete(json);
     }
 }
 
-static void mqtt_event_handler(void *handler_args, esp_event_base_t base, int32_t event_id, void *event_data) {
-    esp_mqtt_event_handle_t event = event_data;
-
-    switch (event->event_id) {
-        case MQTT_EVENT_CONNECTED:
-            ESP_LOGI(TAG, "MQTT conectado");
-            hud_display_message("MQTT ON ",7);
-            // Suscribir al topic para recibir RPC
-            esp_mqtt_client_subscribe(mqtt_client, "v1/devices/me/rpc/request/+", 1);
-            break;
-        case MQTT_EVENT_DISCONNECTED:
-            ESP_LOGI(TAG, "MQTT desconectado");
-            hud_display_message("MQTT OFF",7);
-            break;
-        case MQTT_EVENT_DATA:
-            // Llamar al callback para procesar el mensaje
-            mqtt_event_handler_cb(event);
-            break;
-        default:
-            ESP_LOGI(TAG, "Evento MQTT: %d", event->event_id);
-            break;
+static void mqtt_connection_cb(bool connected) {
+    if (connected) {
+        ESP_LOGI(TAG, "MQTT conectado");
+        boot_phase_done(BOOT_PHASE_MQTT);
+        hud_display_message("MQTT ON ",7);
+        // Suscribir al topic para recibir RPC
+        hal_mqtt_subscribe("v1/devices/me/rpc/request/+", 1);
+        // Y a los atributos compartidos, pidiendo los actuales por si
+        // cambiaron estando desconectado
+        hal_mqtt_subscribe("v1/devices/me/attributes", 1);
+        hal_mqtt_subscribe("v1/devices/me/attributes/response/+", 1);
+        hal_mqtt_publish("v1/devices/me/attributes/request/1",
+                         "{\"sharedKeys\":\"period_ms,gain,tint,batch,deadband\"}", 0, 1);
+        acq_settings_t settings;
+        acq_settings_get(&settings);
+        thingsboard_report_settings(&settings);
+    } else {
+        ESP_LOGI(TAG, "MQTT desconectado");
+        hud_display_message("MQTT OFF",7);
     }
 }
 
 void mqtt_app_start() {
-    esp_mqtt_client_config_t mqtt_cfg = {
-        .broker.address.uri = THINGSBOARD_HOST,
-        .credentials.username = ACCESS_TOKEN,
-    };
-
-    mqtt_client = esp_mqtt_client_init(&mqtt_cfg);
-    esp_mqtt_client_register_event(mqtt_client, ESP_EVENT_ANY_ID, mqtt_event_handler, NULL);
-    esp_mqtt_client_start(mqtt_client);
-}
\ No newline at end of file
+    hal_mqtt_start(THINGSBOARD_HOST, ACCESS_TOKEN, mqtt_connection_cb, mqtt_event_handler_cb, mqtt_published_cb);
+}
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "trace.h"
+
+#if CONFIG_TRACE_ENABLED
+
+// Un anillo por núcleo: cada núcleo escribe solo en el suyo con sus
+// interrupciones enmascaradas, igual que las métricas
+typedef struct {
+    trace_event_t events[CONFIG_TRACE_RING_LEN];
+    uint32_t written;  // Total de eventos escritos (el índice es written % LEN)
+} trace_ring_t;
+
+static trace_ring_t rings[portNUM_PROCESSORS];
+static volatile bool paused = false;  // Durante el volcado no se registra nada
+
+void trace_record(uint8_t event, uint8_t phase, uint16_t arg) {
+    if (paused) {
+        return;
+    }
+
+    uint32_t ts = (uint32_t)esp_timer_get_time();
+    uint32_t irq = portSET_INTERRUPT_MASK_FROM_ISR();
+    trace_ring_t *ring = &rings[xPortGetCoreID()];
+    trace_event_t *e = &ring->events[ring->written % CONFIG_TRACE_RING_LEN];
+    e->ts_us = ts;
+    e->event = event;
+    e->phase = phase;
+    e->arg = arg;
+    ring->written++;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(irq);
+}
+
+esp_err_t trace_dump(trace_sink_t sink, void *ctx) {
+    uint8_t header[8];
+    esp_err_t err;
+
+    memcpy(header, TRACE_MAGIC, 4);
+    header[4] = TRACE_VERSION & 0xFF;
+    header[5] = TRACE_VERSION >> 8;
+    header[6] = portNUM_PROCESSORS & 0xFF;
+    header[7] = portNUM_PROCESSORS >> 8;
+
+    paused = true;
+    err = sink(ctx, (const char *)header, sizeof(header));
+
+    for (int core = 0; core < portNUM_PROCESSORS && err == ESP_OK; core++) {
+        const trace_ring_t *ring = &rings[core];
+        uint32_t count = ring->written < CONFIG_TRACE_RING_LEN ? ring->written : CONFIG_TRACE_RING_LEN;
+        uint32_t first = ring->written - count;
+
+        err = sink(ctx, (const char *)&count, sizeof(count));
+        // Los eventos van del más antiguo al más reciente: como mucho dos tramos contiguos
+        uint32_t start = first % CONFIG_TRACE_RING_LEN;
+        uint32_t tail = count < CONFIG_TRACE_RING_LEN - start ? count : CONFIG_TRACE_RING_LEN - start;
+        if (err == ESP_OK && tail > 0) {
+            err = sink(ctx, (const char *)&ring->events[start], tail * sizeof(trace_event_t));
+        }
+        if (err == ESP_OK && count > tail) {
+            err = sink(ctx, (const char *)&ring->events[0], (count - tail) * sizeof(trace_event_t));
+        }
+    }
+    paused = false;
+    return err;
+}
+
+#else
+
+esp_err_t trace_dump(trace_sink_t sink, void *ctx) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif // CONFIG_TRACE_ENABLED
+
+// Volcado por UART: líneas "TRACE <hex>" entre TRACE_BEGIN y TRACE_END, que
+// tools/trace_to_chrome.py sabe extraer de un log de consola
+static esp_err_t uart_sink(void *ctx, const char *data, size_t len) {
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    while (len > 0) {
+        size_t n = len < 32 ? len : 32;
+        printf("TRACE ");
+        for (size_t i = 0; i < n; i++) {
+            printf("%02x", bytes[i]);
+        }
+        printf("\n");
+        bytes += n;
+        len -= n;
+    }
+    return ESP_OK;
+}
+
+void trace_dump_uart(void) {
+    printf("TRACE_BEGIN\n");
+    trace_dump(uart_sink, NULL);
+    printf("TRACE_END\n");
+    fflush(stdout);
+}
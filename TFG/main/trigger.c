@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include "esp_log.h"
+#include "hal.h"
+#include "metrics.h"
+#include "as7265x.h"
+#include "trigger.h"
+
+static const char *TAG = "trigger";
+
+// Una ranura por sensor_task: la ISR deja en ella el último flanco y despierta
+// a su tarea con una notificación
+typedef struct {
+    TaskHandle_t task;
+    trigger_event_t event;
+    bool pending;
+    bool busy;  // Capturando la ráfaga de un disparo (de trigger_wait a trigger_burst_done)
+} trigger_slot_t;
+
+static trigger_slot_t slots[AS7265X_NUM_HEADS];
+static int num_slots = 0;
+static portMUX_TYPE trigger_lock = portMUX_INITIALIZER_UNLOCKED;
+
+#if CONFIG_TRIGGER_ENABLED
+static uint32_t next_id = 1;
+static int64_t last_edge_us = -CONFIG_TRIGGER_HOLDOFF_MS * 1000LL;
+
+// Desde la ISR del GPIO
+static void trigger_isr(int64_t edge_us) {
+    BaseType_t woken = pdFALSE;
+    bool notify[AS7265X_NUM_HEADS];
+    int missed = 0, overruns = 0;
+
+    // Rebotes del detector: se ignoran los flancos dentro del tiempo de guarda
+    if (edge_us - last_edge_us < CONFIG_TRIGGER_HOLDOFF_MS * 1000LL) {
+        return;
+    }
+    last_edge_us = edge_us;
+
+    portENTER_CRITICAL_ISR(&trigger_lock);
+    uint32_t id = next_id++;
+    for (int i = 0; i < num_slots; i++) {
+        // Con una ráfaga en curso el flanco se descarta: guardado, empezaría
+        // otra ráfaga tarde y con una latencia medida desde un flanco viejo
+        notify[i] = !slots[i].busy;
+        if (!notify[i]) {
+            overruns++;
+            continue;
+        }
+        if (slots[i].pending) {
+            // La tarea no llegó a atender el anterior: se pierde
+            missed++;
+        }
+        slots[i].event = (trigger_event_t){ .id = id, .edge_us = edge_us };
+        slots[i].pending = true;
+    }
+    portEXIT_CRITICAL_ISR(&trigger_lock);
+
+    metrics_count(METRIC_TRIGGERS, 1);
+    if (missed > 0) {
+        metrics_count(METRIC_TRIGGERS_MISSED, missed);
+    }
+    if (overruns > 0) {
+        metrics_count(METRIC_TRIGGER_OVERRUNS, overruns);
+    }
+    for (int i = 0; i < num_slots; i++) {
+        if (notify[i]) {
+            vTaskNotifyGiveFromISR(slots[i].task, &woken);
+        }
+    }
+    portYIELD_FROM_ISR(woken);
+}
+#endif
+
+void trigger_init(void) {
+#if CONFIG_TRIGGER_ENABLED
+#if CONFIG_TRIGGER_EDGE_RISING
+    bool rising = true;
+#else
+    bool rising = false;
+#endif
+    esp_err_t err = hal_trigger_init(CONFIG_TRIGGER_GPIO, rising, trigger_isr);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "No se pudo configurar el disparo en GPIO %d: %s", CONFIG_TRIGGER_GPIO, esp_err_to_name(err));
+        return;
+    }
+    ESP_LOGI(TAG, "Disparo externo en GPIO %d (flanco %s), ráfagas de %d tramas", CONFIG_TRIGGER_GPIO,
+             rising ? "de subida" : "de bajada", CONFIG_TRIGGER_BURST_FRAMES);
+#endif
+}
+
+int trigger_add_sampler(void) {
+    int slot = -1;
+
+    portENTER_CRITICAL(&trigger_lock);
+    if (num_slots < AS7265X_NUM_HEADS) {
+        slot = num_slots;
+        slots[slot] = (trigger_slot_t){ .task = xTaskGetCurrentTaskHandle() };
+        num_slots++;
+    }
+    portEXIT_CRITICAL(&trigger_lock);
+    return slot;
+}
+
+bool trigger_wait(int slot, trigger_event_t *event, TickType_t timeout) {
+    if (ulTaskNotifyTake(pdTRUE, timeout) == 0) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&trigger_lock);
+    bool pending = slots[slot].pending;
+    *event = slots[slot].event;
+    slots[slot].pending = false;
+    slots[slot].busy = pending;
+    portEXIT_CRITICAL(&trigger_lock);
+    return pending;
+}
+
+void trigger_burst_done(int slot) {
+    portENTER_CRITICAL(&trigger_lock);
+    slots[slot].busy = false;
+    portEXIT_CRITICAL(&trigger_lock);
+}
@@ -1,81 +1,74 @@
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <unistd.h>
 #include "esp_log.h"
 #include "esp_http_server.h"
 #include "wifi_ap.h"
 #include "driver/gpio.h"
+#include "ws_stream.h"
+#include "frame_api.h"
+#include "metrics_http.h"
+#include "calibration.h"
+#include "burst.h"
 
 static const char *TAG = "web_server";
 httpd_handle_t server = NULL;
 #define LED_GPIO GPIO_NUM_2  // LED conectado al pin G35
 
-// Página principal con formulario y botón para LED
+// Interfaz web (main/www), comprimida con gzip al compilar y embebida en el firmware
+extern const uint8_t index_html_gz_start[] asm("_binary_index_html_gz_start");
+extern const uint8_t index_html_gz_end[]   asm("_binary_index_html_gz_end");
+extern const uint8_t app_js_gz_start[]     asm("_binary_app_js_gz_start");
+extern const uint8_t app_js_gz_end[]       asm("_binary_app_js_gz_end");
+extern const uint8_t style_css_gz_start[]  asm("_binary_style_css_gz_start");
+extern const uint8_t style_css_gz_end[]    asm("_binary_style_css_gz_end");
+
+typedef struct {
+    const char *uri;
+    const char *type;
+    const uint8_t *start;
+    const uint8_t *end;
+    char etag[12];  // "xxxxxxxx" calculado en la primera petición
+} web_asset_t;
+
+static web_asset_t web_assets[] = {
+    { "/",          "text/html",              index_html_gz_start, index_html_gz_end },
+    { "/app.js",    "application/javascript", app_js_gz_start,     app_js_gz_end },
+    { "/style.css", "text/css",               style_css_gz_start,  style_css_gz_end },
+};
+
+// ETag fuerte: hash FNV-1a del contenido comprimido
+static const char *web_asset_etag(web_asset_t *asset) {
+    if (asset->etag[0] == '\0') {
+        uint32_t hash = 2166136261u;
+        for (const uint8_t *p = asset->start; p < asset->end; p++) {
+            hash = (hash ^ *p) * 16777619u;
+        }
+        snprintf(asset->etag, sizeof(asset->etag), "\"%08" PRIx32 "\"", hash);
+    }
+    return asset->etag;
+}
+
+// Sirve un fichero de la interfaz ya comprimido; responde 304 si el navegador lo tiene en caché
 esp_err_t get_handler(httpd_req_t *req) {
-    const char *html_page = "<!DOCTYPE html>"
-                            "<html lang='es'>"
-                            "<head>"
-                            "<meta charset='UTF-8'>"
-                            "<meta name='viewport' content='width=device-width, initial-scale=1.0'>"
-                            "<title>Configurar WiFi y Controlar LED</title>"
-                            "<style>"
-                            "body { font-family: Arial, sans-serif; text-align: center; padding: 20px; }"
-                            ".container { max-width: 350px; margin: auto; padding: 20px; border-radius: 10px; box-shadow: 0 0 10px rgba(0, 0, 0, 0.1); }"
-                            "input, select { width: 100%; padding: 10px; margin: 10px 0; border: 1px solid #ccc; border-radius: 5px; }"
-                            "button { background: #28a745; color: white; padding: 10px; border: none; border-radius: 5px; cursor: pointer; }"
-                            "button:hover { background: #218838; }"
-                            ".toggle-pass { cursor: pointer; position: absolute; right: 10px; top: 12px; }"
-                            ".password-wrapper { position: relative; display: flex; align-items: center; }"
-                            "#loading { display: none; margin-top: 10px; font-size: 14px; color: #007bff; }"
-                            "</style>"
-                            "</head>"
-                            "<body>"
-                            "<div class='container'>"
-                            "<h2>Ingrese los datos de WiFi</h2>"
-                            "<form id='wifiForm'>"
-                            "<label>SSID:</label>"
-                            "<input type='text' id='ssid' name='ssid' placeholder='Escribe el nombre de la red WiFi'><br>"
-                            "<label>Contraseña:</label>"
-                            "<div class='password-wrapper'>"
-                            "<input type='password' id='password' name='password' placeholder='Escribe la contraseña'><span class='toggle-pass' onclick='togglePassword()'>👁️</span>"
-                            "</div>"
-                            "<br>"
-                            "<button type='submit'>Conectar</button>"
-                            "<p id='loading'>Conectando...</p>"
-                            "</form>"
-                            "<br>"
-                            "<h3>Control del LED</h3>"
-                            "<button id='ledToggleButton' onclick='toggleLED()'>Encender LED</button>"
-                            "</div>"
-
-                            "<script>"
-                            "function togglePassword() {"
-                            "  var passInput = document.getElementById('password');"
-                            "  passInput.type = passInput.type === 'password' ? 'text' : 'password';"
-                            "} "
-                            "function toggleLED() {"
-                            "  fetch('/led_toggle')"
-                            "    .then(response => response.text())"
-                            "    .then(data => {"
-                            "      alert(data);"
-                            "      var button = document.getElementById('ledToggleButton');"
-                            "      button.innerHTML = button.innerHTML === 'Encender LED' ? 'Apagar LED' : 'Encender LED';"
-                            "    });"
-                            "}"
-                            
-                            "document.getElementById('wifiForm').addEventListener('submit', function(event) {"
-                            "  event.preventDefault();"
-                            "  document.getElementById('loading').style.display = 'block';"
-                            "  var formData = new FormData(this);"
-                            "  fetch('/connect', { method: 'POST', body: new URLSearchParams(formData) })"
-                            "    .then(response => response.text())"
-                            "    .then(data => alert(data))"
-                            "    .finally(() => document.getElementById('loading').style.display = 'none');"
-                            "});"
-                            "</script>"
-                            "</body></html>";
-
-    httpd_resp_send(req, html_page, HTTPD_RESP_USE_STRLEN);
-    return ESP_OK;
+    web_asset_t *asset = (web_asset_t *)req->user_ctx;
+    const char *etag = web_asset_etag(asset);
+    char if_none_match[16];
+
+    httpd_resp_set_hdr(req, "ETag", etag);
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+
+    if (httpd_req_get_hdr_value_str(req, "If-None-Match", if_none_match, sizeof(if_none_match)) == ESP_OK &&
+        strcmp(if_none_match, etag) == 0) {
+        httpd_resp_set_status(req, "304 Not Modified");
+        return httpd_resp_send(req, NULL, 0);
+    }
+
+    httpd_resp_set_type(req, asset->type);
+    httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+    return httpd_resp_send(req, (const char *)asset->start, asset->end - asset->start);
 }
 
 // Manejador para recibir credenciales WiFi
@@ -134,20 +127,150 @@ esp_err_t led_toggle_handler(httpd_req_t *req) {
     return ESP_OK;
 }
 
+// Cabezal indicado con ?head=N (0 si no se indica)
+static int query_head(httpd_req_t *req) {
+    char query[48], head[4];
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "head", head, sizeof(head)) == ESP_OK) {
+        return atoi(head);
+    }
+    return 0;
+}
+
+static esp_err_t send_calibration_status(httpd_req_t *req, int head) {
+    calibration_status_t st;
+    char json[176];
+    static const char *const kinds[] = { "dark", "white" };
+
+    if (calibration_get_status(head, &st) != ESP_OK) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Cabezal inexistente");
+        return ESP_OK;
+    }
+    snprintf(json, sizeof(json),
+             "{\"head\":%d,\"gain\":%u,\"tint\":%u,\"dark\":%s,\"white\":%s,\"capturing\":%s%s%s,\"remaining\":%d}",
+             head, st.gain, st.tint, st.valid[CAL_REF_DARK] ? "true" : "false",
+             st.valid[CAL_REF_WHITE] ? "true" : "false",
+             st.capturing >= 0 ? "\"" : "", st.capturing >= 0 ? kinds[st.capturing] : "null",
+             st.capturing >= 0 ? "\"" : "", st.remaining);
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_send(req, json, HTTPD_RESP_USE_STRLEN);
+}
+
+// GET /api/calibration[?head=N]: estado de las referencias para la ganancia y Tint actuales
+static esp_err_t calibration_get_handler(httpd_req_t *req) {
+    return send_calibration_status(req, query_head(req));
+}
+
+// POST /api/calibration?ref=dark|white|clear&frames=N[&head=N]
+static esp_err_t calibration_post_handler(httpd_req_t *req) {
+    int head = query_head(req);
+    char query[48], ref[8] = "", frames[8] = "";
+    esp_err_t err;
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        httpd_query_key_value(query, "ref", ref, sizeof(ref));
+        httpd_query_key_value(query, "frames", frames, sizeof(frames));
+    }
+
+    if (strcmp(ref, "dark") == 0) {
+        err = calibration_request(head, CAL_REF_DARK, atoi(frames));
+    } else if (strcmp(ref, "white") == 0) {
+        err = calibration_request(head, CAL_REF_WHITE, atoi(frames));
+    } else if (strcmp(ref, "clear") == 0) {
+        err = calibration_clear(head);
+    } else {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "ref debe ser dark, white o clear");
+        return ESP_OK;
+    }
+
+    if (err == ESP_ERR_INVALID_STATE) {
+        httpd_resp_set_status(req, "409 Conflict");
+    } else if (err != ESP_OK && err != ESP_ERR_INVALID_ARG) {
+        httpd_resp_set_status(req, HTTPD_500);
+    }
+    return send_calibration_status(req, head);
+}
+
+static esp_err_t send_burst_status(httpd_req_t *req) {
+    burst_status_t st;
+    char json[160];
+
+    burst_get_status(&st);
+    snprintf(json, sizeof(json),
+             "{\"id\":%" PRIu32 ",\"state\":\"%s\",\"head\":%d,\"frames\":%d,\"captured\":%d,"
+             "\"duration_ms\":%" PRId64 ",\"fps\":%.1f}",
+             st.id, burst_state_name(st.state), st.head, st.requested, st.captured, st.duration_us / 1000,
+             st.duration_us > 0 ? st.captured * 1e6 / st.duration_us : 0.0);
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_send(req, json, HTTPD_RESP_USE_STRLEN);
+}
+
+// GET /api/burst: estado de la última ráfaga a RAM
+static esp_err_t burst_get_handler(httpd_req_t *req) {
+    return send_burst_status(req);
+}
+
+// POST /api/burst?frames=K[&head=N]: las tramas se publican juntas al terminar
+static esp_err_t burst_post_handler(httpd_req_t *req) {
+    char query[48], frames[8] = "";
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        httpd_query_key_value(query, "frames", frames, sizeof(frames));
+    }
+
+    esp_err_t err = burst_request(query_head(req), atoi(frames));
+    if (err == ESP_ERR_INVALID_ARG) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "frames o head fuera de rango");
+        return ESP_OK;
+    } else if (err == ESP_ERR_INVALID_STATE) {
+        httpd_resp_set_status(req, "409 Conflict");
+    }
+    return send_burst_status(req);
+}
+
+// Cierre de cada sesión de httpd: libera su hueco de /ws/spectrum antes de
+// que una conexión nueva reutilice el descriptor
+static void session_close(httpd_handle_t hd, int sockfd) {
+    ws_stream_session_closed(sockfd);
+    close(sockfd);
+}
+
 // Iniciar servidor web
 void start_webserver() {
+    if (server) {
+        ESP_LOGI(TAG, "El servidor HTTP ya estaba iniciado.");
+        return;
+    }
+
     httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    config.max_uri_handlers = 20;
+    config.close_fn = session_close;
     esp_err_t err = httpd_start(&server, &config);
 
     if (err == ESP_OK) {
         ESP_LOGI(TAG, "Servidor HTTP iniciado con éxito.");
-        httpd_uri_t uri_get = { .uri = "/", .method = HTTP_GET, .handler = get_handler };
         httpd_uri_t uri_post = { .uri = "/connect", .method = HTTP_POST, .handler = post_handler };
         httpd_uri_t uri_led = { .uri = "/led_toggle", .method = HTTP_GET, .handler = led_toggle_handler };
+        httpd_uri_t uri_cal_get = { .uri = "/api/calibration", .method = HTTP_GET, .handler = calibration_get_handler };
+        httpd_uri_t uri_cal_post = { .uri = "/api/calibration", .method = HTTP_POST, .handler = calibration_post_handler };
+        httpd_uri_t uri_burst_get = { .uri = "/api/burst", .method = HTTP_GET, .handler = burst_get_handler };
+        httpd_uri_t uri_burst_post = { .uri = "/api/burst", .method = HTTP_POST, .handler = burst_post_handler };
 
-        httpd_register_uri_handler(server, &uri_get);
+        for (int i = 0; i < sizeof(web_assets) / sizeof(web_assets[0]); i++) {
+            httpd_uri_t uri_get = { .uri = web_assets[i].uri, .method = HTTP_GET,
+                                    .handler = get_handler, .user_ctx = &web_assets[i] };
+            httpd_register_uri_handler(server, &uri_get);
+        }
         httpd_register_uri_handler(server, &uri_post);
         httpd_register_uri_handler(server, &uri_led);
+        httpd_register_uri_handler(server, &uri_cal_get);
+        httpd_register_uri_handler(server, &uri_cal_post);
+        httpd_register_uri_handler(server, &uri_burst_get);
+        httpd_register_uri_handler(server, &uri_burst_post);
+        ws_stream_register(server);
+        frame_api_register(server);
+        metrics_register(server);
     } else {
         ESP_LOGE(TAG, "Error al iniciar el servidor HTTP: %s", esp_err_to_name(err));
     }
@@ -9,6 +9,9 @@
 #include "esp_http_client.h"
 #include "thingsboard_control.h"
 #include "oled.h"
+#include "boot.h"
+#include "hal.h"
+#include "freertos/event_groups.h"
 
 #define AP_SSID "ESP32_AP"
 #define AP_PASS "12345678"
@@ -19,6 +22,11 @@ static bool wifi_connected = false;
 static esp_netif_t *sta_netif = NULL;
 static esp_netif_t *ap_netif = NULL;
 
+// Bit que pone el manejador al obtener IP, para no esperar un tiempo fijo
+#define WIFI_GOT_IP_BIT BIT0
+#define WIFI_CONNECT_TIMEOUT_MS 10000
+static EventGroupHandle_t wifi_events = NULL;
+
 // Manejador de eventos WiFi
 static void wifi_event_handler(void *arg, esp_event_base_t event_base, int32_t event_id, void *event_data) {
     if (event_base == WIFI_EVENT) {
@@ -49,6 +57,9 @@ static void wifi_event_handler(void *arg, esp_event_base_t event_base, int32_t e
         hud_display_message("",3);
         hud_display_wifi(true);
         wifi_connected = true;
+        hal_time_sync_start();  // Para el "ts" de lotes y ráfagas
+        boot_phase_done(BOOT_PHASE_WIFI);
+        xEventGroupSetBits(wifi_events, WIFI_GOT_IP_BIT);
     }
 }
 
@@ -107,6 +118,7 @@ void start_wifi_ap() {
     esp_wifi_start();
 
     ESP_LOGI(TAG, "Modo AP iniciado. SSID: %s", AP_SSID);
+    boot_phase_done(BOOT_PHASE_WIFI);
     start_webserver();
 }
 
@@ -114,6 +126,9 @@ void start_wifi_ap() {
 void connect_to_wifi(const char *ssid, const char *password) {
 
     ESP_LOGI(TAG, "Intentando conectar a WiFi: %s...", ssid);
+    if (wifi_events == NULL) {
+        wifi_events = xEventGroupCreate();
+    }
     esp_netif_init();
     esp_event_loop_create_default();
 
@@ -136,13 +151,15 @@ void connect_to_wifi(const char *ssid, const char *password) {
     esp_wifi_set_config(WIFI_IF_STA, &wifi_config);
     esp_wifi_start();
 
-    // Esperar 10 segundos para verificar la conexión
-    vTaskDelay(pdMS_TO_TICKS(10000));
+    // Esperar la IP como mucho 10 segundos
+    xEventGroupWaitBits(wifi_events, WIFI_GOT_IP_BIT, pdFALSE, pdTRUE, pdMS_TO_TICKS(WIFI_CONNECT_TIMEOUT_MS));
 
     if (wifi_is_connected()) {
         ESP_LOGI(TAG, "Conectado a %s", ssid);
-        check_internet_connection();
+        // MQTT primero: la comprobación de Internet es solo diagnóstico y bloquea
         mqtt_app_start();
+        start_webserver();  // Servidor local también en modo estación (stream en vivo)
+        check_internet_connection();
     } else {
         ESP_LOGE(TAG, "No se pudo conectar. Volviendo a modo AP...");
         start_wifi_ap();
@@ -0,0 +1,186 @@
+#include <string.h>
+#include "esp_log.h"
+#include "esp_http_server.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sample_ring.h"
+#include "ws_stream.h"
+#include "metrics.h"
+
+static const char *TAG = "ws_stream";
+
+#define WS_MAX_CLIENTS CONFIG_WS_SPECTRUM_MAX_CLIENTS
+
+// Cada cliente tiene su propio buffer de envío. Mientras un envío está en
+// curso (busy) las tramas nuevas para ese cliente se descartan, así un
+// cliente lento no retiene memoria ni frena a los demás.
+typedef struct {
+    int fd;                                // Socket del cliente, -1 si está libre
+    bool busy;                             // Hay un envío asíncrono pendiente
+    uint32_t dropped;                      // Tramas descartadas por contrapresión
+    uint8_t buf[SAMPLE_FRAME_WIRE_SIZE];   // Trama en vuelo
+} ws_client_t;
+
+static ws_client_t clients[WS_MAX_CLIENTS];
+static portMUX_TYPE clients_lock = portMUX_INITIALIZER_UNLOCKED;
+static httpd_handle_t ws_server = NULL;
+static TaskHandle_t ws_task = NULL;
+
+// Registra el socket si no lo estaba ya; false si no queda hueco
+static bool ws_client_add(int fd) {
+    ws_client_t *slot = NULL;
+
+    taskENTER_CRITICAL(&clients_lock);
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+        if (clients[i].fd == fd) {
+            taskEXIT_CRITICAL(&clients_lock);
+            return true;
+        }
+        if (clients[i].fd == -1 && slot == NULL) {
+            slot = &clients[i];
+        }
+    }
+    if (slot != NULL) {
+        slot->fd = fd;
+        slot->busy = false;
+        slot->dropped = 0;
+    }
+    taskEXIT_CRITICAL(&clients_lock);
+    return slot != NULL;
+}
+
+// Libera el hueco si sigue siendo de fd (httpd reutiliza los descriptores)
+static void ws_client_remove(ws_client_t *client, int fd) {
+    taskENTER_CRITICAL(&clients_lock);
+    if (client->fd == fd) {
+        client->fd = -1;
+        client->busy = false;
+    }
+    taskEXIT_CRITICAL(&clients_lock);
+}
+
+void ws_stream_session_closed(int fd) {
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+        ws_client_remove(&clients[i], fd);
+    }
+}
+
+// Se ejecuta en la tarea de httpd cuando termina un envío asíncrono
+static void ws_send_done(esp_err_t err, int socket, void *arg) {
+    ws_client_t *client = (ws_client_t *)arg;
+
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Cliente %d desconectado (%s)", socket, esp_err_to_name(err));
+        ws_client_remove(client, socket);
+        return;
+    }
+    taskENTER_CRITICAL(&clients_lock);
+    if (client->fd == socket) {
+        client->busy = false;
+    }
+    taskEXIT_CRITICAL(&clients_lock);
+}
+
+// Envía una trama a todos los clientes que no tengan un envío pendiente
+static void ws_broadcast(const sample_frame_t *frame) {
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+        ws_client_t *client = &clients[i];
+
+        taskENTER_CRITICAL(&clients_lock);
+        int fd = client->fd;
+        bool busy = client->busy;
+        if (fd != -1 && busy) {
+            client->dropped++;
+        } else if (fd != -1) {
+            client->busy = true;
+        }
+        taskEXIT_CRITICAL(&clients_lock);
+
+        if (fd != -1 && busy) {
+            metrics_count(METRIC_WS_FRAMES_DROPPED, 1);
+        }
+        if (fd == -1 || busy) {
+            continue;
+        }
+        if (httpd_ws_get_fd_info(ws_server, fd) != HTTPD_WS_CLIENT_WEBSOCKET) {
+            ws_client_remove(client, fd);
+            continue;
+        }
+
+        httpd_ws_frame_t ws_frame = {
+            .final = true,
+            .type = HTTPD_WS_TYPE_BINARY,
+            .payload = client->buf,
+            .len = sample_frame_pack(frame, client->buf),
+        };
+        if (httpd_ws_send_data_async(ws_server, fd, &ws_frame, ws_send_done, client) != ESP_OK) {
+            ws_client_remove(client, fd);
+        }
+    }
+}
+
+// Tarea suscrita al bus de tramas que reparte cada trama nueva (si el anillo
+// la adelanta, salta a la más antigua)
+static void ws_stream_task(void *pvParameter) {
+    sample_ring_sub_t sub;
+    const sample_frame_t *frame;
+
+    sample_ring_subscribe(&sub, xTaskGetCurrentTaskHandle());
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while ((frame = sample_ring_next(&sub)) != NULL) {
+            ws_broadcast(frame);
+            sample_ring_release(frame);
+        }
+    }
+}
+
+// Manejador de /ws/spectrum: registra al cliente en el handshake
+static esp_err_t ws_spectrum_handler(httpd_req_t *req) {
+    if (req->method == HTTP_GET) {
+        int fd = httpd_req_to_sockfd(req);
+        if (!ws_client_add(fd)) {
+            // Se cierra la conexión en lugar de dejarla abierta sin tramas
+            ESP_LOGW(TAG, "Cliente WebSocket %d rechazado: ya hay %d", fd, WS_MAX_CLIENTS);
+            return ESP_FAIL;
+        }
+        ESP_LOGI(TAG, "Nuevo cliente WebSocket: %d", fd);
+        return ESP_OK;
+    }
+
+    // El stream es unidireccional: se leen y descartan los mensajes del cliente
+    uint8_t payload[32];
+    httpd_ws_frame_t ws_frame = { .payload = payload };
+    esp_err_t ret = httpd_ws_recv_frame(req, &ws_frame, 0);
+    if (ret != ESP_OK || ws_frame.len == 0) {
+        return ret;
+    }
+    if (ws_frame.len > sizeof(payload)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return httpd_ws_recv_frame(req, &ws_frame, sizeof(payload));
+}
+
+// Registra /ws/spectrum en el servidor y arranca la tarea de difusión
+esp_err_t ws_stream_register(httpd_handle_t server) {
+    httpd_uri_t uri_ws = {
+        .uri = "/ws/spectrum",
+        .method = HTTP_GET,
+        .handler = ws_spectrum_handler,
+        .is_websocket = true,
+    };
+
+    taskENTER_CRITICAL(&clients_lock);
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+        clients[i].fd = -1;
+        clients[i].busy = false;
+    }
+    ws_server = server;
+    taskEXIT_CRITICAL(&clients_lock);
+
+    if (ws_task == NULL) {
+        xTaskCreate(ws_stream_task, "ws_stream_task", 3072, NULL, 4, &ws_task);
+    }
+    return httpd_register_uri_handler(server, &uri_ws);
+}
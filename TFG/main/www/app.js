@@ -0,0 +1,77 @@
+function togglePassword() {
+  var passInput = document.getElementById('password');
+  passInput.type = passInput.type === 'password' ? 'text' : 'password';
+}
+
+function toggleLED() {
+  fetch('/led_toggle')
+    .then(response => response.text())
+    .then(data => {
+      alert(data);
+      var button = document.getElementById('ledToggleButton');
+      button.innerHTML = button.innerHTML === 'Encender LED' ? 'Apagar LED' : 'Encender LED';
+    });
+}
+
+document.getElementById('wifiForm').addEventListener('submit', function(event) {
+  event.preventDefault();
+  document.getElementById('loading').style.display = 'block';
+  var formData = new FormData(this);
+  fetch('/connect', { method: 'POST', body: new URLSearchParams(formData) })
+    .then(response => response.text())
+    .then(data => alert(data))
+    .finally(() => document.getElementById('loading').style.display = 'none');
+});
+
+// Canales en el orden de la trama (RSTUVW GHIJKL ABCDEF) y su
+// posición al dibujarlos ordenados por longitud de onda
+var CANALES = 'RSTUVWGHIJKLABCDEF';
+var ORDEN = [12, 13, 14, 15, 16, 17, 6, 7, 0, 8, 1, 9, 2, 3, 4, 5, 10, 11];
+
+function drawSpectrum(v) {
+  var c = document.getElementById('spectrum'), g = c.getContext('2d');
+  var max = Math.max.apply(null, v) || 1, w = c.width / 18, h0 = c.height - 14;
+  g.clearRect(0, 0, c.width, c.height);
+  ORDEN.forEach(function(ch, i) {
+    var h = h0 * v[ch] / max;
+    g.fillStyle = '#28a745'; g.fillRect(i * w + 1, h0 - h, w - 2, h);
+    g.fillStyle = '#333'; g.fillText(CANALES[ch], i * w + w / 3, c.height - 2);
+  });
+}
+
+// Trama binaria de /ws/spectrum: seq (u32) | ts (i64) | temperatura (i16) | 18 x u16 | cabezal (u8)
+function startSpectrum() {
+  var ws = new WebSocket('ws://' + location.host + '/ws/spectrum');
+  ws.binaryType = 'arraybuffer';
+  ws.onmessage = function(e) {
+    var d = new DataView(e.data), v = [];
+    for (var i = 0; i < 18; i++) v.push(d.getUint16(14 + 2 * i, true));
+    drawSpectrum(v);
+    document.getElementById('spectrumInfo').innerHTML =
+      'Cabezal ' + d.getUint8(50) + ' - trama ' + d.getUint32(0, true) + ' - ' + d.getInt16(12, true) + ' °C';
+  };
+  ws.onclose = function() { setTimeout(startSpectrum, 2000); };
+}
+
+startSpectrum();
+
+// Referencias de calibración (oscura con el sensor tapado, blanca sobre el
+// patrón) para la ganancia y Tint actuales
+function showCalibration(c) {
+  var info = c.capturing ? 'Capturando ' + c.capturing + ' (' + c.remaining + ' tramas)'
+                         : 'Oscura: ' + (c.dark ? 'sí' : 'no') + ' - Blanca: ' + (c.white ? 'sí' : 'no');
+  document.getElementById('calibrationInfo').innerHTML = info + ' - ganancia ' + c.gain + ', Tint ' + c.tint;
+  if (c.capturing) setTimeout(refreshCalibration, 1000);
+}
+
+function refreshCalibration() {
+  fetch('/api/calibration').then(r => r.json()).then(showCalibration);
+}
+
+function calibrate(ref) {
+  fetch('/api/calibration?ref=' + ref, { method: 'POST' })
+    .then(r => { if (r.status == 409) alert('Ya hay una captura en curso'); return r.json(); })
+    .then(showCalibration);
+}
+
+refreshCalibration();
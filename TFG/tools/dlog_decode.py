@@ -0,0 +1,77 @@
+#!/usr/bin/env python
+# Decodifica el log diferido del firmware (include/dlog.h).
+#
+# La entrada puede ser el binario de /log.bin o un log de consola con las
+# líneas "DLOG <hex>" de dlog_dump_uart(). Los formatos se leen de
+# include/dlog_formats.h, así que hay que usar el de la misma versión del firmware.
+import argparse
+import os
+import re
+import struct
+import sys
+
+FORMATOS_H = os.path.join(os.path.dirname(__file__), '..', 'include', 'dlog_formats.h')
+NIVELES = {1: 'E', 2: 'W', 3: 'I', 4: 'D'}
+
+
+def cargar_formatos(ruta):
+    with open(ruta, encoding='utf-8') as f:
+        texto = f.read()
+    return [fmt for _, fmt in re.findall(r'X\((\w+),\s*"((?:[^"\\]|\\.)*)"\)', texto)]
+
+
+def leer_volcado(ruta):
+    with open(ruta, 'rb') as f:
+        datos = f.read()
+    if datos.startswith(b'SPLG'):
+        return datos
+    hexadecimal = []
+    for linea in datos.decode('utf-8', errors='replace').splitlines():
+        linea = linea.strip()
+        if linea == 'DLOG_BEGIN':
+            hexadecimal = []
+        elif linea.startswith('DLOG '):
+            hexadecimal.append(linea[5:])
+    return bytes.fromhex(''.join(hexadecimal))
+
+
+def formatear(fmt, args):
+    # Los argumentos se guardan como u32: %d/%i se reinterpretan con signo y
+    # %c como carácter; el resto se pasa tal cual al operador % de Python
+    conversiones = re.findall(r'%[-+ #0-9.]*([a-zA-Z%])', fmt)
+    valores = []
+    for conv, valor in zip([c for c in conversiones if c != '%'], args):
+        if conv in 'di' and valor >= 1 << 31:
+            valor -= 1 << 32
+        valores.append(valor)
+    return fmt.replace('%u', '%d') % tuple(valores)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decodifica el log diferido del firmware')
+    parser.add_argument('entrada', help='log.bin o log de UART con líneas DLOG')
+    parser.add_argument('--formatos', default=FORMATOS_H)
+    args = parser.parse_args()
+
+    formatos = cargar_formatos(args.formatos)
+    datos = leer_volcado(args.entrada)
+    if datos[:4] != b'SPLG':
+        sys.exit('el volcado no empieza por la cabecera SPLG')
+    version, tam_registro, cuenta = struct.unpack_from('<HHI', datos, 4)
+    if version != 1:
+        sys.exit(f'versión de log no soportada: {version}')
+
+    pos = 12
+    for _ in range(cuenta):
+        ts, ident, nivel, nargs = struct.unpack_from('<IHBB', datos, pos)
+        valores = struct.unpack_from(f'<{nargs}I', datos, pos + 8)
+        pos += tam_registro
+        if ident < len(formatos):
+            texto = formatear(formatos[ident], valores)
+        else:
+            texto = f'formato desconocido {ident}: {list(valores)}'
+        print(f'{NIVELES.get(nivel, "?")} ({ts / 1000:.3f}) {texto}')
+
+
+if __name__ == '__main__':
+    main()
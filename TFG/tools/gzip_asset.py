@@ -0,0 +1,14 @@
+#!/usr/bin/env python
+# Comprime un fichero de la interfaz web con gzip para embeberlo en el firmware.
+# mtime=0 hace que la salida sea reproducible (y el ETag estable entre compilaciones).
+import gzip
+import sys
+
+if len(sys.argv) != 3:
+    sys.exit('uso: gzip_asset.py <entrada> <salida.gz>')
+
+with open(sys.argv[1], 'rb') as f:
+    data = f.read()
+
+with open(sys.argv[2], 'wb') as f:
+    f.write(gzip.compress(data, compresslevel=9, mtime=0))
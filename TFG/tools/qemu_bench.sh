@@ -0,0 +1,71 @@
+#!/usr/bin/env bash
+# Benchmark extremo a extremo del firmware en el QEMU de Espressif.
+#
+# Compila la imagen con sdkconfig.qemu (AS7265x simulado, Ethernet openeth),
+# levanta mosquitto en localhost como sustituto de ThingsBoard, arranca QEMU y
+# recoge las líneas BENCH que imprime el firmware al acabar la ventana de medida.
+#
+# Uso: tools/qemu_bench.sh [duración_s]   (requiere idf.py, qemu-system-xtensa,
+#      mosquitto y mosquitto_sub en el PATH)
+set -euo pipefail
+
+DURATION=${1:-60}
+PORT=${BENCH_BROKER_PORT:-1883}
+cd "$(dirname "$0")/.."
+BUILD=build-qemu
+mkdir -p "$BUILD"
+
+# sdkconfig se regenera en cada ejecución para que se apliquen los valores por defecto
+rm -f "$BUILD/sdkconfig"
+echo "CONFIG_BENCH_DURATION_S=$DURATION" > "$BUILD/sdkconfig.bench"
+idf.py -B "$BUILD" -D SDKCONFIG="$BUILD/sdkconfig" \
+       -D SDKCONFIG_DEFAULTS="sdkconfig;sdkconfig.qemu;$BUILD/sdkconfig.bench" build
+
+(cd "$BUILD" && esptool.py --chip esp32 merge_bin --fill-flash-size 2MB -o flash_qemu.bin @flash_args)
+
+PIDS=()
+cleanup() {
+    for pid in "${PIDS[@]}"; do
+        kill "$pid" 2>/dev/null || true
+    done
+}
+trap cleanup EXIT
+
+# Broker local: QEMU (red de usuario) ve el anfitrión como 10.0.2.2
+cat > "$BUILD/mosquitto.conf" <<CONF
+listener $PORT 127.0.0.1
+allow_anonymous true
+CONF
+mosquitto -c "$BUILD/mosquitto.conf" > "$BUILD/mosquitto.log" 2>&1 &
+PIDS+=($!)
+sleep 1
+mosquitto_sub -h 127.0.0.1 -p "$PORT" -t v1/devices/me/telemetry > "$BUILD/broker_frames.log" &
+PIDS+=($!)
+
+qemu-system-xtensa -nographic -machine esp32 -m 4M \
+    -drive file="$BUILD/flash_qemu.bin",if=mtd,format=raw \
+    -nic user,model=open_eth \
+    -serial file:"$BUILD/qemu_uart.log" -monitor none &
+QEMU_PID=$!
+PIDS+=($QEMU_PID)
+
+# Arranque + calentamiento + ventana de medida, con margen
+DEADLINE=$((SECONDS + DURATION + 120))
+until grep -q '^BENCH_DONE' "$BUILD/qemu_uart.log" 2>/dev/null; do
+    if [ $SECONDS -ge $DEADLINE ] || ! kill -0 $QEMU_PID 2>/dev/null; then
+        echo "El firmware no terminó el benchmark; ver $BUILD/qemu_uart.log" >&2
+        exit 1
+    fi
+    sleep 1
+done
+
+echo "==== Benchmark QEMU ($DURATION s) ===="
+grep '^BENCH ' "$BUILD/qemu_uart.log" | sed 's/^BENCH //'
+echo "broker_frames_received_total=$(wc -l < "$BUILD/broker_frames.log")"
+
+if grep -q '^TRACE ' "$BUILD/qemu_uart.log"; then
+    python3 tools/trace_to_chrome.py "$BUILD/qemu_uart.log" -o "$BUILD/trace.json"
+fi
+if grep -q '^DLOG ' "$BUILD/qemu_uart.log"; then
+    python3 tools/dlog_decode.py "$BUILD/qemu_uart.log" > "$BUILD/dlog.txt"
+fi
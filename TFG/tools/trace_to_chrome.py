@@ -0,0 +1,92 @@
+#!/usr/bin/env python
+# Convierte un volcado del anillo de trazas (include/trace.h) al formato JSON
+# de Chrome (chrome://tracing, https://ui.perfetto.dev).
+#
+# La entrada puede ser el binario de /trace.bin o un log de consola con las
+# líneas "TRACE <hex>" de trace_dump_uart(). Cada núcleo aparece como un hilo.
+import argparse
+import json
+import struct
+import sys
+
+EVENTOS = {
+    1: 'seleccion dispositivo',
+    2: 'lectura registro virtual',
+    3: 'trama completa',
+    4: 'serializacion',
+    5: 'publicacion',
+    6: 'PUBACK',
+    7: 'HUD',
+}
+ARGUMENTOS = {1: 'sensor', 2: 'registro', 5: 'msg_id', 6: 'msg_id', 7: 'pagina'}
+
+
+def leer_volcado(ruta):
+    with open(ruta, 'rb') as f:
+        datos = f.read()
+    if datos.startswith(b'SPTR'):
+        return datos
+    # Log de consola: se juntan las líneas TRACE del último volcado
+    hexadecimal = []
+    for linea in datos.decode('utf-8', errors='replace').splitlines():
+        linea = linea.strip()
+        if linea == 'TRACE_BEGIN':
+            hexadecimal = []
+        elif linea.startswith('TRACE '):
+            hexadecimal.append(linea[6:])
+    return bytes.fromhex(''.join(hexadecimal))
+
+
+def convertir(datos):
+    if datos[:4] != b'SPTR':
+        sys.exit('el volcado no empieza por la cabecera SPTR')
+    version, nucleos = struct.unpack_from('<HH', datos, 4)
+    if version != 1:
+        sys.exit(f'versión de traza no soportada: {version}')
+
+    eventos = []
+    pos = 8
+    for nucleo in range(nucleos):
+        (cuenta,) = struct.unpack_from('<I', datos, pos)
+        pos += 4
+        base = 0
+        anterior = None
+        for _ in range(cuenta):
+            ts, evento, fase, arg = struct.unpack_from('<IBBH', datos, pos)
+            pos += 8
+            # Marca de tiempo de 32 bits: se deshace la vuelta (~71 min)
+            if anterior is not None and ts < anterior:
+                base += 1 << 32
+            anterior = ts
+            e = {
+                'name': EVENTOS.get(evento, f'evento {evento}'),
+                'ph': chr(fase),
+                'ts': base + ts,
+                'pid': 0,
+                'tid': nucleo,
+            }
+            if fase == ord('i'):
+                e['s'] = 't'
+            if evento in ARGUMENTOS:
+                e['args'] = {ARGUMENTOS[evento]: arg}
+            eventos.append(e)
+
+    nombres = [{'name': 'thread_name', 'ph': 'M', 'pid': 0, 'tid': n, 'args': {'name': f'core {n}'}}
+               for n in range(nucleos)]
+    return {'traceEvents': nombres + eventos, 'displayTimeUnit': 'ms'}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('entrada', help='trace.bin o log de UART con líneas TRACE')
+    parser.add_argument('-o', '--salida', default='trace.json')
+    args = parser.parse_args()
+
+    traza = convertir(leer_volcado(args.entrada))
+    with open(args.salida, 'w') as f:
+        json.dump(traza, f)
+    print(f'{len(traza["traceEvents"])} eventos escritos en {args.salida}')
+
+
+if __name__ == '__main__':
+    main()